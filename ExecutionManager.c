@@ -17,6 +17,8 @@ execution_mgr* EM_execution_manager_init(int (*cb_execute)(void *h5_ctx, void *p
     em->app_ctx = app_ctx;
     gen_queue_init(&(em->execution_q));
     em->execute_cb = cb_execute;
+    em->execute_batch_cb = NULL;
+    em->executed_cnt = 0;
     return em;
 }
 
@@ -44,6 +46,42 @@ int EM_execute(execution_mgr* em, void* pbuf_in){
     return (em->execute_cb)(em->app_ctx, pbuf_in);
 }
 
+int EM_set_batch_cb(execution_mgr* em, int (*cb_execute_batch)(void *h5_ctx, void **proposal_bufs, int cnt)){
+    assert(em);
+    em->execute_batch_cb = cb_execute_batch;
+    return 0;
+}
+
+int EM_execute_batch(execution_mgr* em, void** pbufs, int cnt){
+    assert(em && (pbufs || cnt == 0));
+    if(cnt == 0)
+        return 0;
+    em->executed_cnt += cnt;
+    if(em->execute_batch_cb)
+        return (em->execute_batch_cb)(em->app_ctx, pbufs, cnt);
+    for(int i = 0; i < cnt; i++)
+        EM_execute(em, pbufs[i]);
+    return 0;
+}
+
+typedef struct em_sort_rec{
+    time_stamp time;
+    proposal_id pid;
+    int idx;//position in execution_q, keeps the sort stable
+    Queue_node* node;
+}em_sort_rec;
+
+// Same order as EM_get_oldest_record(): time, then smaller pid, then queue order.
+static int _em_rec_cmp(const void* a, const void* b){
+    const em_sort_rec* ra = a;
+    const em_sort_rec* rb = b;
+    if(ra->time != rb->time)
+        return ra->time < rb->time ? -1 : 1;
+    if(ra->pid != rb->pid)
+        return ra->pid < rb->pid ? -1 : 1;
+    return ra->idx - rb->idx;
+}
+
 Queue_node* EM_get_oldest_record(execution_mgr* em, time_stamp* pp_time_out){
     assert(em && pp_time_out);
     if(em->execution_q.node_cnt == 0 || em->execution_q.q_state != Q_ACTIVE)
@@ -93,16 +131,35 @@ int EM_execute_all(execution_mgr* em){
     //DEBUG_PRINT
     //printf("%s: rank %d, Start to execute, cnt = %d, current time = %lu\n",
     //        __func__, MY_RANK_DEBUG, em->execution_q.node_cnt, EM_get_time_stamp_us());
-    while(em->execution_q.head){
-        time_stamp t;
-        Queue_node* old = EM_get_oldest_record(em, &t);
-        void* prop_buf = old->data;
-        //printf("%s: rank = %d, to execute: pid = %d, time = %lu, node cnt = %d\n",
-        //        __func__, MY_RANK_DEBUG,
-        //        ((proposal*)(old->data))->pid, ((proposal*)(old->data))->time, em->execution_q.node_cnt);
-        EM_execute(em, prop_buf);
-        gen_queue_remove(&(em->execution_q), old, 1);
+    int cnt = em->execution_q.node_cnt;
+    if(cnt == 0 || !em->execution_q.head)
+        return -1;
+
+    // Sort the whole ready set once instead of rescanning for the oldest each time.
+    // Only the fixed header is read, the payload stays encoded for the callback.
+    em_sort_rec* recs = calloc(cnt, sizeof(em_sort_rec));
+    void** bufs = calloc(cnt, sizeof(void*));
+    Queue_node* cur = em->execution_q.head;
+    int n = 0;
+    while(cur && n < cnt){
+        assert(cur->data);
+        recs[n].time = ((proposal*)(cur->data))->time;
+        recs[n].pid = ((proposal*)(cur->data))->pid;
+        recs[n].idx = n;
+        recs[n].node = cur;
+        n++;
+        cur = cur->next;
     }
+    qsort(recs, n, sizeof(em_sort_rec), _em_rec_cmp);
+    for(int i = 0; i < n; i++)
+        bufs[i] = recs[i].node->data;
+
+    EM_execute_batch(em, bufs, n);
+
+    for(int i = 0; i < n; i++)
+        gen_queue_remove(&(em->execution_q), recs[i].node, 1);
+    free(bufs);
+    free(recs);
     return -1;
 }
 
@@ -15,6 +15,8 @@ typedef struct execution_manager {
     gen_queue execution_q;
     void* app_ctx;
     int (*execute_cb)(void* h5_ctx, void* proposal_buf);//int h5_op_type,
+    int (*execute_batch_cb)(void* h5_ctx, void** proposal_bufs, int cnt);//optional, NULL to loop execute_cb
+    unsigned long executed_cnt;//all proposals executed so far, mine and remote
 }
 execution_mgr;
 
@@ -23,6 +25,8 @@ execution_mgr* EM_execution_manager_init( int (*cb_execute)(void *h5_ctx, void *
 int EM_execution_manager_term(execution_mgr* em);
 int EM_add_proposal(execution_mgr* em, Queue_node* pp);
 int EM_execute(execution_mgr* em, void* proposal_buf);
+int EM_set_batch_cb(execution_mgr* em, int (*cb_execute_batch)(void *h5_ctx, void **proposal_bufs, int cnt));
+int EM_execute_batch(execution_mgr* em, void** proposal_bufs, int cnt);//bufs already in execution order
 int EM_execute_all(execution_mgr* em);
 int EM_execute_cnt(execution_mgr *em);
 
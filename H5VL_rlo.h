@@ -27,18 +27,59 @@
 #define H5VL_RLO_PASSTHRU_VALUE       515           /* VOL connector ID */
 #define H5VL_RLO_PASSTHRU_VERSION     0
 
+/* Voting plugin that orders the proposals ("voting=" in the info string) */
+typedef enum H5VL_rlo_voting_t {
+    H5VL_RLO_VOTING_RLO = 0,    /* "rlo": rootless voting + time window (default) */
+    H5VL_RLO_VOTING_RMA,        /* "rma": global sequence # from an MPI RMA counter, no window */
+    H5VL_RLO_VOTING_SEQ,        /* "seq": central sequencer judges and numbers proposals, no window */
+    H5VL_RLO_VOTING_POSIX       /* "posix": shared memory ring, single node only, no window */
+} H5VL_rlo_voting_t;
+
+/* Dataset optional operation, see H5VL_rlo_dataset_reserve().  Arguments
+ * after the operation: hsize_t nrows, hsize_t *start_out */
+#define H5VL_RLO_DATASET_RESERVE    1024
+
+/* Object optional operation, see H5VL_rlo_create_multi().  Arguments after
+ * the operation: size_t count, const H5VL_rlo_create_t *objs */
+#define H5VL_RLO_OBJECT_CREATE_MULTI    1025
+
+/* One object for H5VL_rlo_create_multi(): a dataset, or a group when
+ * 'type_id' is H5I_INVALID_HID ('space_id' is then ignored) */
+typedef struct H5VL_rlo_create_t {
+    hid_t loc_id;               /* Parent file or group */
+    const char *name;
+    hid_t type_id;
+    hid_t space_id;
+    hid_t lcpl_id;
+    hid_t cpl_id;               /* Dataset or group creation property list */
+    hid_t apl_id;               /* Dataset or group access property list */
+} H5VL_rlo_create_t;
+
+/* Counters of one file, see H5VL_rlo_get_stats() */
+typedef struct H5VL_rlo_stats_t {
+    unsigned long remote;       /* Other ranks' operations run here, or journaled */
+    unsigned long journaled;    /* Lazy mode: of those, still in the journal */
+    unsigned long early;        /* Commute mode: operations run before the window ended */
+    unsigned long votes;        /* Our own operations put up for a vote */
+    unsigned long announced;    /* Our own operations under a lease, not voted on */
+} H5VL_rlo_stats_t;
+
 /* Pass-through VOL connector info */
 
 typedef struct H5VL_rlo_pass_through_info_t {
     hid_t under_vol_id;         /* VOL ID for under VOL */
     void *under_vol_info;       /* VOL info for under VOL */
     unsigned long time_window_size;
-    int mode; //1 for regular, 2 for risky
+    int mode; //1 for regular, 2 for risky, 3 for epoch-batched
     //Public:from property list, for duping.
     MPI_Comm mpi_comm;
     MPI_Info mpi_info;
     int world_size;
     int my_rank;
+    H5VL_rlo_voting_t voting;
+    int lazy; //1 to journal remote operations and apply them when needed
+    int commute; //1 to run operations on unrelated objects without waiting out the time window
+    int lease; //1 to create objects without voting under groups this rank created
 } H5VL_rlo_pass_through_info_t;
 //this is initialized with the 2 env vars .
 /* Use herr_t
@@ -63,6 +104,19 @@ const void *H5PLget_plugin_info(void);
 
 H5_DLL hid_t H5VL_rlo_pass_through_register(void);
 
+/* Reserve 'nrows' rows at the end of the first (unlimited) dimension of a
+ * dataset for this rank; the first one is returned in 'start_out' */
+H5_DLL herr_t H5VL_rlo_dataset_reserve(hid_t dset_id, hsize_t nrows, hsize_t *start_out);
+/* Create 'count' datasets and groups (all in one file) with one proposal;
+ * with 'ids_out', return an open handle for each */
+H5_DLL herr_t H5VL_rlo_create_multi(size_t count, const H5VL_rlo_create_t *objs, hid_t *ids_out);
+/* Mark a link (or attribute) creation property list as collective: all
+ * ranks make the same create with it, which then runs once */
+H5_DLL herr_t H5VL_rlo_set_collective(hid_t plist_id, hbool_t collective);
+
+/* Make progress on the file 'obj_id' is in, then return its counters */
+H5_DLL herr_t H5VL_rlo_get_stats(hid_t obj_id, H5VL_rlo_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
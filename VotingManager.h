@@ -29,6 +29,12 @@ typedef enum VotingPlugin_type{
     VP_DEFAULT
 }vp_type;
 
+// How approved proposals are ordered before execution
+typedef enum VotingPlugin_order{
+    VP_ORDER_TIME_WINDOW,   // by (time, pid), executed once aged out of the time window
+    VP_ORDER_SEQUENCE       // proposal time is a gap-free global sequence #, executed in that order
+}vp_order;
+
 typedef struct VotingPluginCtx{
     vp_type vp_type;
     void* comm; //communicator, for MPI, it's of MPI_COMM type.
@@ -36,6 +42,7 @@ typedef struct VotingPluginCtx{
 
 typedef struct VotingMechanism{
     void* vp_ctx_in;//RLO_engine_t
+    vp_order order;
     //vp_info_in: init info for vp, such as mpi_comm and mpi_info.
     int (*vp_init)(int (*app_cb)(), void* app_ctx, void* vp_info_in, void** vp_ctx_out);          // Initialize the voting mechanism
                                 // (Probably needs to pass pointer to Ledger to output)
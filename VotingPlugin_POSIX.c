@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "VotingPlugin_POSIX.h"
+extern int MY_RANK_DEBUG;
+
+#define SHM_ALIGN(x)    (((x) + 63) & ~((size_t)63))
+
+// ========================== Private functions ==========================
+
+// Process-shared futex: the words live in the shm segment.
+static void _futex_wait(shm_hdr* hdr, _Atomic uint32_t* addr, uint32_t val, long usec){
+    atomic_fetch_add(&(hdr->waiters), 1);
+#ifdef __linux__
+    struct timespec ts = {0, usec * 1000};
+    syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAIT, val, &ts, NULL, 0);
+#else
+    if(atomic_load(addr) == val)
+        usleep(usec);
+#endif
+    atomic_fetch_sub(&(hdr->waiters), 1);
+}
+
+static void _futex_wake_all(shm_hdr* hdr, _Atomic uint32_t* addr){
+    atomic_fetch_add(addr, 1);
+#ifdef __linux__
+    if(atomic_load(&(hdr->waiters)) > 0)
+        syscall(SYS_futex, (uint32_t*)addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+static uint64_t _min_read_seq(VP_ctx_posix* ctx){
+    uint64_t min = atomic_load(&(ctx->read_seq[0]));
+    for(int i = 1; i < ctx->hdr->comm_size; i++){
+        uint64_t s = atomic_load(&(ctx->read_seq[i]));
+        if(s < min)
+            min = s;
+    }
+    return min;
+}
+
+// Move everything published past my cursor into recv_q, so my slots are
+// freed even while I'm blocked publishing my own. Returns # of proposals
+// received.
+static int _ring_drain(VP_ctx_posix* ctx){
+    _Atomic uint64_t* my_cursor = &(ctx->read_seq[ctx->my_rank]);
+    int cnt = 0;
+
+    while(1){
+        uint64_t cursor = atomic_load(my_cursor);
+        shm_slot* slot = &(ctx->slots[cursor % VP_POSIX_SLOT_CNT]);
+        uint32_t pub = atomic_load(&(ctx->hdr->published));
+
+        if(cursor >= atomic_load(&(ctx->hdr->next_seq)))
+            break;// Nothing handed out past my cursor
+
+        if(atomic_load(&(slot->ready_seq)) != cursor + 1){
+            // Taken but not published yet: the writer is between its
+            // claim and the copy, sleep briefly instead of spinning.
+            _futex_wait(ctx->hdr, &(ctx->hdr->published), pub, VP_POSIX_WAIT_USEC);
+            if(atomic_load(&(slot->ready_seq)) != cursor + 1)
+                break;
+        }
+
+        // My own are added to the ledger by the caller.
+        if(slot->origin != ctx->my_rank){
+            void* buf = calloc(1, slot->len);
+            memcpy(buf, slot->data, slot->len);
+            gen_queue_append(&(ctx->recv_q), gen_queue_node_new(buf));
+            cnt++;
+        }
+
+        atomic_store(my_cursor, cursor + 1);
+        _futex_wake_all(ctx->hdr, &(ctx->hdr->consumed));
+    }
+    return cnt;
+}
+
+// Take the next sequence # once its slot has been read by every rank.
+// Readers stop at a taken # until it's published, so a writer waiting for
+// room must not hold one. Blocks while the ring is full.
+static uint64_t _ring_claim(VP_ctx_posix* ctx){
+    uint64_t seq = atomic_load(&(ctx->hdr->next_seq));
+
+    while(1){
+        // A failed exchange reloads seq
+        if(seq < _min_read_seq(ctx) + VP_POSIX_SLOT_CNT){
+            if(atomic_compare_exchange_weak(&(ctx->hdr->next_seq), &seq, seq + 1))
+                return seq;
+            continue;
+        }
+
+        uint32_t c = atomic_load(&(ctx->hdr->consumed));
+        _ring_drain(ctx);
+        if(seq >= _min_read_seq(ctx) + VP_POSIX_SLOT_CNT)
+            _futex_wait(ctx->hdr, &(ctx->hdr->consumed), c, VP_POSIX_WAIT_USEC);
+        seq = atomic_load(&(ctx->hdr->next_seq));
+    }
+}
+
+// Publish an encoded proposal under the next sequence #. Returns -1, and
+// publishes nothing, if it doesn't fit in a slot.
+static int _ring_publish(VP_ctx_posix* ctx, proposal* proposal_in){
+    void* proposal_buf = NULL;
+    size_t len;
+    uint64_t seq;
+    shm_slot* slot;
+
+    len = proposal_encoder(proposal_in, &proposal_buf);
+    if(len > VP_POSIX_SLOT_SIZE){
+        printf("%s:%d: rank = %d, proposal of %lu bytes exceeds the %d byte slot, dropped.\n",
+                __func__, __LINE__, MY_RANK_DEBUG, len, VP_POSIX_SLOT_SIZE);
+        free(proposal_buf);
+        return -1;
+    }
+    seq = _ring_claim(ctx);
+    slot = &(ctx->slots[seq % VP_POSIX_SLOT_CNT]);
+
+    // The sequence # is the ordering key, the ledger executes in this order.
+    proposal_in->time = seq;
+    proposal_buf_set_time(proposal_buf, seq);
+
+    slot->origin = ctx->my_rank;
+    slot->len = len;
+    memcpy(slot->data, proposal_buf, len);
+    atomic_store(&(slot->ready_seq), seq + 1);
+    _futex_wake_all(ctx->hdr, &(ctx->hdr->published));
+
+    free(proposal_buf);
+    return 0;
+}
+
+// ========================== Public functions ==========================
+
+int vp_comm_fits_POSIX(MPI_Comm comm){
+    MPI_Comm node_comm;
+    int comm_size, node_size, fits, all_fit;
+
+    // Shared memory only reaches ranks on my node.
+    MPI_Comm_size(comm, &comm_size);
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_size(node_comm, &node_size);
+    MPI_Comm_free(&node_comm);
+    fits = (node_size == comm_size);
+    MPI_Allreduce(&fits, &all_fit, 1, MPI_INT, MPI_MIN, comm);
+    return all_fit;
+}
+
+int vp_init_POSIX(int (*h5_judgement)(), void* h5ctx, void* vp_info_in, void** vp_ctx_out){
+    vp_info_posix* vp_info = (vp_info_posix*)vp_info_in;
+    VP_ctx_posix* ctx = calloc(1, sizeof(VP_ctx_posix));
+    MPI_Comm comm = vp_info->mpi_comm;
+    int comm_size;
+    size_t read_seq_off, slots_off;
+    int fd;
+    void* base;
+
+    MPI_Comm_rank(comm, &(ctx->my_rank));
+    MPI_Comm_size(comm, &comm_size);
+
+    read_seq_off = SHM_ALIGN(sizeof(shm_hdr));
+    slots_off = SHM_ALIGN(read_seq_off + comm_size * sizeof(_Atomic uint64_t));
+    ctx->shm_size = slots_off + VP_POSIX_SLOT_CNT * sizeof(shm_slot);
+
+    if(ctx->my_rank == 0){
+        static int shm_cnt = 0;
+        sprintf(ctx->shm_name, "/h5rlo_vp_%d_%d", (int)getpid(), shm_cnt++);
+        fd = shm_open(ctx->shm_name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        assert(fd >= 0);
+        if(ftruncate(fd, ctx->shm_size) != 0)
+            assert(0 && "ftruncate() failed on shm segment");
+    }
+    MPI_Bcast(ctx->shm_name, sizeof(ctx->shm_name), MPI_CHAR, 0, comm);
+    if(ctx->my_rank != 0){
+        MPI_Barrier(comm);// Created and sized
+        fd = shm_open(ctx->shm_name, O_RDWR, S_IRUSR | S_IWUSR);
+        assert(fd >= 0);
+    }
+
+    base = mmap(NULL, ctx->shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    assert(base != MAP_FAILED);
+    close(fd);
+
+    ctx->hdr = (shm_hdr*)base;
+    ctx->read_seq = (_Atomic uint64_t*)((char*)base + read_seq_off);
+    ctx->slots = (shm_slot*)((char*)base + slots_off);
+    ctx->my_state = PS_DEFAULT;
+    gen_queue_init(&(ctx->recv_q));
+
+    if(ctx->my_rank == 0){
+        // ftruncate() zero-filled the rest
+        ctx->hdr->comm_size = comm_size;
+        atomic_thread_fence(memory_order_seq_cst);
+        MPI_Barrier(comm);
+    }
+
+    // Everyone has it mapped, remove the name so nothing is left behind.
+    MPI_Barrier(comm);
+    if(ctx->my_rank == 0)
+        shm_unlink(ctx->shm_name);
+
+    DEBUG_PRINT
+    *vp_ctx_out = (void*)ctx;
+    return 0;
+}
+
+int vp_finalize_POSIX(void* vp_ctx){
+    assert(vp_ctx);
+    VP_ctx_posix* ctx = (VP_ctx_posix*)vp_ctx;
+
+    munmap(ctx->hdr, ctx->shm_size);
+    while(ctx->recv_q.head){
+        Queue_node* node = ctx->recv_q.head;
+        gen_queue_remove(&(ctx->recv_q), node, 0);
+        gen_queue_node_delete(node);
+    }
+    free(ctx);
+    return 1;
+}
+
+int vp_submit_proposal_POSIX(void* vp_ctx, proposal* proposal_in){
+    assert(vp_ctx && proposal_in);
+    VP_ctx_posix* ctx = (VP_ctx_posix*)vp_ctx;
+
+    // Too big for the ring: nobody else sees it, it's voted down here
+    if(_ring_publish(ctx, proposal_in) < 0){
+        ctx->my_state = PS_DENIED;
+        return -1;
+    }
+    ctx->my_state = PS_APPROVED;
+    return 0;
+}
+
+// Every proposal is sequenced, so a plain bcast gets the same treatment.
+int vp_submit_bcast_POSIX(void* vp_ctx, proposal* proposal_in){
+    return vp_submit_proposal_POSIX(vp_ctx, proposal_in);
+}
+
+int vp_check_my_proposal_state_POSIX(void* vp_ctx, proposal_id pid){
+    assert(vp_ctx);
+    VP_ctx_posix* ctx = (VP_ctx_posix*)vp_ctx;
+    return ctx->my_state;
+}
+
+int vp_checkout_proposal_POSIX(void* vp_ctx, void** prop_buf){
+    assert(vp_ctx);
+    VP_ctx_posix* ctx = (VP_ctx_posix*)vp_ctx;
+    Queue_node* node;
+
+    if(!ctx->recv_q.head)
+        _ring_drain(ctx);
+
+    node = ctx->recv_q.head;
+    if(node){
+        *prop_buf = node->data;
+        gen_queue_remove(&(ctx->recv_q), node, 1);
+        return 1;
+    }
+    return 0;
+}
+
+// Writers publish synchronously, but a full ring only gets room when every
+// rank reads: do that here too, not only when the ledger asks for more.
+int vp_make_progress_POSIX(void* vp_ctx){
+    assert(vp_ctx);
+    VP_ctx_posix* ctx = (VP_ctx_posix*)vp_ctx;
+
+    return _ring_drain(ctx);
+}
+
+int vp_rm_my_proposal_POSIX(void* vp_ctx){
+    assert(vp_ctx);
+    VP_ctx_posix* ctx = (VP_ctx_posix*)vp_ctx;
+
+    ctx->my_state = PS_DEFAULT;
+    return 0;
+}
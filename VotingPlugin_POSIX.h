@@ -0,0 +1,84 @@
+/*
+ * VotingPlugin_POSIX.h
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Node-local plugin (VP_POSIX): all ranks share one POSIX shared memory
+ *  ring buffer. A proposal takes the next sequence # with an atomic
+ *  compare-exchange once its slot is free, and is published there; readers
+ *  are woken with a futex. No MPI messages
+ *  after setup and no time window, the ledger executes in sequence order.
+ *  Only for communicators that fit on a single node.
+ *  A slot is free again once every rank has read it, and a rank reads only
+ *  when it calls into the connector: a rank that stops doing so for long
+ *  makes the others wait for room once the ring is full.
+ */
+
+#ifndef VOTINGPLUGIN_POSIX_H_
+#define VOTINGPLUGIN_POSIX_H_
+
+#include <mpi.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "rootless_ops.h"       // RLO_MSG_SIZE_MAX
+#include "util_queue.h"
+#include "proposal.h"
+#include "VotingManager.h"
+#include "util_debug.h"
+
+#define VP_POSIX_SLOT_CNT       128
+#define VP_POSIX_SLOT_SIZE      RLO_MSG_SIZE_MAX    // Max encoded proposal size, as with the RLO engine
+#define VP_POSIX_WAIT_USEC      100         // Max futex sleep while waiting for a slot
+
+typedef struct vp_info_in_POSIX{
+    MPI_Comm mpi_comm;          // Only used to set up the shared segment
+    MPI_Info mpi_info;
+}vp_info_posix;
+
+typedef struct shm_ring_slot{
+    _Atomic uint64_t ready_seq; // seq + 1 once the data is published
+    int origin;
+    size_t len;
+    char data[VP_POSIX_SLOT_SIZE];
+}shm_slot;
+
+typedef struct shm_ring_header{
+    _Atomic uint64_t next_seq;  // Next sequence # to hand out
+    _Atomic uint32_t published; // Futex word, bumped on each publish
+    _Atomic uint32_t consumed;  // Futex word, bumped when a reader frees slots
+    _Atomic uint32_t waiters;   // # of ranks in futex wait, skip the wake syscall when 0
+    int comm_size;
+    // Followed by: _Atomic uint64_t read_seq[comm_size], shm_slot slots[VP_POSIX_SLOT_CNT]
+}shm_hdr;
+
+typedef struct VP_ctx_out_POSIX{
+    int my_rank;
+    char shm_name[64];
+    size_t shm_size;
+    shm_hdr* hdr;
+    _Atomic uint64_t* read_seq; // Per-rank read cursor, in the segment
+    shm_slot* slots;
+    gen_queue recv_q;           // Read off the ring, not checked out yet
+    proposal_state my_state;
+}VP_ctx_posix;
+
+// Collective over comm: 1 if all its ranks are on one node, else 0. Check
+// it before vp_init_POSIX(), which takes it for granted.
+int vp_comm_fits_POSIX(MPI_Comm comm);
+
+int vp_init_POSIX(int (*h5_judgement)(), void* h5ctx, void* vp_info_in, void** vp_ctx_out);
+
+int vp_finalize_POSIX(void* vp_ctx);
+
+int vp_submit_proposal_POSIX(void* vp_ctx, proposal* proposal);
+int vp_submit_bcast_POSIX(void* vp_ctx, proposal* proposal);
+
+int vp_check_my_proposal_state_POSIX(void* vp_ctx, proposal_id pid);
+
+int vp_checkout_proposal_POSIX(void* vp_ctx, void** prop_buf_out);
+
+int vp_rm_my_proposal_POSIX(void* vp_ctx);
+
+int vp_make_progress_POSIX(void* vp_ctx);
+
+#endif /* VOTINGPLUGIN_POSIX_H_ */
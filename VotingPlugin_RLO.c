@@ -6,39 +6,296 @@ extern int MY_RANK_DEBUG;
 //    RLO_finalize,       // 'finalize' implementation
 //};
 
+// Engines in use, one per communicator, see vp_rlo_pool
+static vp_rlo_pool* Pools = NULL;
+
+static vp_rlo_chan* _pool_chan(vp_rlo_pool* pool, int channel){
+    for(vp_rlo_chan* c = pool->chans; c; c = c->next)
+        if(c->channel == channel)
+            return c;
+    return NULL;
+}
+
+// The engine's judgement callback: pass the proposal on to its channel's.
+// A channel not open here yet has nothing to object to.
+static int _pool_judgement(const void* buf, void* app_ctx){
+    vp_rlo_pool* pool = (vp_rlo_pool*)app_ctx;
+    vp_rlo_chan* c = _pool_chan(pool, *(const int*)buf);
+
+    if(!c)
+        return 1;
+    return (c->judgement)((const char*)buf + sizeof(int), c->app_ctx);
+}
+
+// Copy out a picked up buf without the channel # in front
+static void* _strip_channel(const void* buf, size_t len){
+    void* out = calloc(1, len - sizeof(int));
+
+    memcpy(out, (const char*)buf + sizeof(int), len - sizeof(int));
+    return out;
+}
+
+// Sort everything the engine has picked up into the channels' queues
+static void _pool_pickup(vp_rlo_pool* pool){
+    RLO_user_msg* msg_out = NULL;
+
+    while(RLO_user_pickup_next(pool->eng, &msg_out)){
+        PBuf* b = NULL;
+        int channel;
+        vp_rlo_chan* c;
+
+        assert(msg_out->data);
+        pbuf_deserialize(msg_out->data + sizeof(size_t), &b);
+        channel = *(int*)(b->data);
+        c = _pool_chan(pool, channel);
+        if(c)
+            gen_queue_append(&(c->pickup_q), gen_queue_node_new(_strip_channel(b->data, b->data_len)));
+        else{// Kept until it opens here, or dropped when it closes
+            void* copy = calloc(1, b->data_len);
+
+            memcpy(copy, b->data, b->data_len);
+            gen_queue_append(&(pool->stray_q), gen_queue_node_new(copy));
+        }
+
+        RLO_user_msg_recycle(pool->eng, msg_out);
+        pbuf_free(b);
+    }
+}
+
+// Move the engine along, and when it's done with my current proposal, hand
+// it the next channel's.
+static void _pool_pump(vp_rlo_pool* pool){
+    RLO_Req_stat st = RLO_check_my_proposal_state(pool->eng, pool->owner ? pool->owner->my_pid : 0);
+
+    if(pool->owner && (st == RLO_COMPLETED || st == RLO_FAILED)){
+        pool->owner->my_state = (st == RLO_COMPLETED) ? PS_APPROVED : PS_DENIED;
+        pool->owner = NULL;
+    }
+    if(!pool->owner){
+        for(vp_rlo_chan* c = pool->chans; c; c = c->next){
+            if(c->my_buf && c->my_state == PS_DEFAULT){
+                pool->owner = c;
+                c->my_state = PS_IN_PROGRESS;
+                RLO_submit_proposal(pool->eng, c->my_buf, c->my_len, c->my_pid);
+                break;
+            }
+        }
+    }
+}
+
+static vp_rlo_pool* _pool_find(MPI_Comm comm){
+    vp_rlo_pool* pool;
+    int cmp;
+
+    for(pool = Pools; pool; pool = pool->next){
+        MPI_Comm_compare(comm, pool->comm, &cmp);
+        if(cmp == MPI_IDENT)
+            break;
+    }
+    return pool;
+}
+
+// The pool for comm, with a new engine if there's none yet: collective then
+static vp_rlo_pool* _pool_get(MPI_Comm comm){
+    vp_rlo_pool* pool = _pool_find(comm);
+
+    if(pool)
+        return pool;
+
+    void* proposal_action = NULL;
+
+    pool = calloc(1, sizeof(vp_rlo_pool));
+    pool->comm = comm;
+    gen_queue_init(&(pool->stray_q));
+    DEBUG_PRINT
+    pool->eng = RLO_progress_engine_new(comm, RLO_MSG_SIZE_MAX, _pool_judgement, pool, proposal_action);
+    DEBUG_PRINT
+    pool->next = Pools;
+    Pools = pool;
+    return pool;
+}
+
+// Drop whatever was parked for a channel that's going away
+static void _pool_drop_strays(vp_rlo_pool* pool, int channel){
+    for(Queue_node* node = pool->stray_q.head; node; ){
+        Queue_node* next = node->next;
+
+        if(*(int*)(node->data) == channel){
+            free(node->data);
+            gen_queue_remove(&(pool->stray_q), node, 1);
+        }
+        node = next;
+    }
+}
+
+// One reservation fewer, the engine goes with the last one: collective then
+static void _pool_unref(vp_rlo_pool* pool){
+    vp_rlo_pool** pp;
+    int ret;
+
+    if(--pool->ref_cnt > 0)
+        return;
+    ret = RLO_progress_engine_cleanup(pool->eng);
+    assert(ret == 0);
+    while(pool->stray_q.head){
+        free(pool->stray_q.head->data);
+        gen_queue_remove(&(pool->stray_q), pool->stray_q.head, 1);
+    }
+    for(pp = &Pools; *pp != pool; pp = &((*pp)->next))
+        ;
+    *pp = pool->next;
+    free(pool);
+}
+
 // ========================== Public functions ==========================
 //func_cb: judgement callback
 
+int vp_bcast_eng_RLO(RLO_engine_t* eng, proposal* proposal_in){
+    assert(eng && proposal_in);
+
+    void* proposal_buf = NULL;
+    size_t prop_total_size = proposal_encoder(proposal_in, &proposal_buf);
+    void* pbuf_buf = NULL;
+    size_t pbuf_len = 0;
+    pbuf_serialize(proposal_in->pid, 1, 0, prop_total_size, proposal_buf, &pbuf_buf, &pbuf_len);
+    RLO_msg_t* bcast_msg = RLO_msg_new_bc(eng, pbuf_buf, pbuf_len);
+    DEBUG_PRINT
+    RLO_bcast_gen(eng, bcast_msg, RLO_BCAST);
+    DEBUG_PRINT
+    free(proposal_buf);
+    return 0;
+}
+
+int vp_pickup_eng_RLO(RLO_engine_t* eng, void** prop_buf){
+    RLO_user_msg* msg_out = NULL;
+
+    assert(eng);
+    if(!RLO_user_pickup_next(eng, &msg_out))
+        return 0;
+
+    PBuf* b = NULL;
+    assert(msg_out->data);
+    pbuf_deserialize(msg_out->data + sizeof(size_t), &b);
+    *prop_buf = calloc(1, b->data_len);
+    memcpy(*prop_buf, b->data, b->data_len);
+
+    RLO_user_msg_recycle(eng, msg_out);
+    pbuf_free(b);
+    return 1;
+}
+
+int vp_reserve_channel_RLO(MPI_Comm comm){
+    vp_rlo_pool* pool = _pool_get(comm);
+
+    pool->ref_cnt++;
+    return pool->next_channel++;
+}
+
+int vp_release_channel_RLO(MPI_Comm comm, int channel){
+    vp_rlo_pool* pool = _pool_find(comm);
+
+    assert(pool && !_pool_chan(pool, channel));
+    _pool_drop_strays(pool, channel);
+    _pool_unref(pool);
+    return 0;
+}
+
+int vp_progress_RLO(MPI_Comm comm){
+    vp_rlo_pool* pool = _pool_find(comm);
+
+    assert(pool);
+    _pool_pump(pool);
+    return 0;
+}
 
 int vp_init_RLO(int (*h5_judgement)(), void* h5ctx, void* vp_info_in, void** vp_ctx_out){
     vp_info_rlo* vp_info = (vp_info_rlo*)vp_info_in;
     DEBUG_PRINT
     MPI_Comm comm = vp_info->mpi_comm;
+    int channel = vp_info->channel;
+    vp_rlo_pool* pool;
+    vp_rlo_chan* c;
 
-    void* proposal_action = NULL;
-    DEBUG_PRINT
-    RLO_engine_t* eng = RLO_progress_engine_new(comm, RLO_MSG_SIZE_MAX, h5_judgement, h5ctx, proposal_action);
-    DEBUG_PRINT
-    *vp_ctx_out = (void*)eng;
+    // Without a reservation this is the collective step
+    if(channel < 0)
+        channel = vp_reserve_channel_RLO(comm);
+    pool = _pool_find(comm);
+    assert(pool && !_pool_chan(pool, channel));
+
+    c = calloc(1, sizeof(vp_rlo_chan));
+    c->pool = pool;
+    c->channel = channel;
+    c->judgement = h5_judgement;
+    c->app_ctx = h5ctx;
+    gen_queue_init(&(c->pickup_q));
+    c->my_state = PS_DEFAULT;
+    c->next = pool->chans;
+    pool->chans = c;
+
+    // Whatever came in for it before it opened here
+    for(Queue_node* node = pool->stray_q.head; node; ){
+        Queue_node* next = node->next;
+
+        if(*(int*)(node->data) == c->channel){
+            // Only pickups land here, their size is in the proposal itself
+            size_t len = sizeof(int) + proposal_buf_size((char*)node->data + sizeof(int));
+
+            gen_queue_append(&(c->pickup_q), gen_queue_node_new(_strip_channel(node->data, len)));
+            free(node->data);
+            gen_queue_remove(&(pool->stray_q), node, 1);
+        }
+        node = next;
+    }
+
+    *vp_ctx_out = (void*)c;
     return 0;
 }
 
+// Closes the channel, and the engine along with the last one: collective then.
 int vp_finalize_RLO(void* vp_ctx){
-    int ret;
     assert(vp_ctx);
-    RLO_engine_t* eng = (RLO_engine_t*)vp_ctx;
-    ret = RLO_progress_engine_cleanup(eng);
-    assert(ret == 0);
+    vp_rlo_chan* c = (vp_rlo_chan*)vp_ctx;
+    vp_rlo_pool* pool = c->pool;
+    vp_rlo_chan** pp;
+
+    while(pool->owner == c)
+        _pool_pump(pool);
+    for(pp = &(pool->chans); *pp != c; pp = &((*pp)->next))
+        ;
+    *pp = c->next;
+    while(c->pickup_q.head){
+        free(c->pickup_q.head->data);
+        gen_queue_remove(&(c->pickup_q), c->pickup_q.head, 1);
+    }
+    _pool_drop_strays(pool, c->channel);
+    free(c->my_buf);
+    free(c);
+
+    _pool_unref(pool);
     return 1;
 }
 
+// Prefix an encoded proposal with the channel #
+static void* _chan_encode(vp_rlo_chan* c, proposal* proposal_in, size_t* len_out){
+    void* proposal_buf = NULL;
+    size_t prop_total_size = proposal_encoder(proposal_in, &proposal_buf);
+    char* buf = calloc(1, sizeof(int) + prop_total_size);
+
+    *(int*)buf = c->channel;
+    memcpy(buf + sizeof(int), proposal_buf, prop_total_size);
+    free(proposal_buf);
+    *len_out = sizeof(int) + prop_total_size;
+    return buf;
+}
+
 int vp_submit_bcast_RLO(void* vp_ctx, proposal* proposal_in){//direct bcast, no voting
     assert(vp_ctx && proposal_in);
-    RLO_engine_t* eng = (RLO_engine_t*)vp_ctx;
+    vp_rlo_chan* c = (vp_rlo_chan*)vp_ctx;
+    RLO_engine_t* eng = c->pool->eng;
 
     //proposal_test(proposal_in);
-    void* proposal_buf = NULL;
-    size_t prop_total_size = proposal_encoder(proposal_in, &proposal_buf);
+    size_t prop_total_size = 0;
+    void* proposal_buf = _chan_encode(c, proposal_in, &prop_total_size);
     void* pbuf_buf = NULL;
     size_t pbuf_len = 0;
     pbuf_serialize(proposal_in->pid, 1, 0, prop_total_size, proposal_buf, &pbuf_buf, &pbuf_len);
@@ -50,42 +307,50 @@ int vp_submit_bcast_RLO(void* vp_ctx, proposal* proposal_in){//direct bcast, no
     return 0;
 }
 
+// Queued behind any other channel's proposal the engine is still voting on.
 int vp_submit_proposal_RLO(void* vp_ctx, proposal* proposal_in){
     assert(vp_ctx && proposal_in);
-    RLO_engine_t* eng = (RLO_engine_t*)vp_ctx;
+    vp_rlo_chan* c = (vp_rlo_chan*)vp_ctx;
 
     //proposal_test(proposal_in);
-    void* proposal_buf = NULL;
+    assert(c->pool->owner != c);
+    free(c->my_buf);
+    c->my_buf = _chan_encode(c, proposal_in, &(c->my_len));
+    c->my_pid = proposal_in->pid;
+    c->my_state = PS_DEFAULT;
+    //printf("%s:%u, proposal_encoder: p_data len = %lu, prop_total_size = %lu, pid = %d\n", __func__, __LINE__, proposal_in->p_data_len, c->my_len, proposal_in->pid);
+    _pool_pump(c->pool);
 
-    size_t prop_total_size = proposal_encoder(proposal_in, &proposal_buf);
-    //proposal_buf_test(proposal_buf);
-    //printf("%s:%u, proposal_encoder: p_data len = %lu, prop_total_size = %lu, pid = %d\n", __func__, __LINE__, proposal_in->p_data_len, prop_total_size, proposal_in->pid);
-    return RLO_submit_proposal(eng, proposal_buf, prop_total_size, proposal_in->pid);
+    if(c->my_state == PS_APPROVED)
+        return 1;
+    else if(c->my_state == PS_DENIED)
+        return 0;
+    return -1;// not complete
 }
 
 int vp_check_my_proposal_state_RLO(void* vp_ctx, proposal_id pid){
     assert(vp_ctx);
     //DEBUG_PRINT
-    RLO_engine_t* eng = (RLO_engine_t*)vp_ctx;
-    RLO_Req_stat ps = RLO_check_my_proposal_state(eng, pid);
+    vp_rlo_chan* c = (vp_rlo_chan*)vp_ctx;
+    _pool_pump(c->pool);
     //DEBUG_PRINT
     proposal_state ret = PS_DEFAULT;
-    switch(ps){
-        case RLO_IN_PROGRESS:
+    if(!c->my_buf || c->my_pid != pid)
+        return ret;
+    switch(c->my_state){
+        case PS_DEFAULT:        // Still waiting for the engine
+        case PS_IN_PROGRESS:
             //DEBUG_PRINT
             ret = PS_IN_PROGRESS;
             break;
-        case RLO_COMPLETED:
+        case PS_APPROVED:
             DEBUG_PRINT
             ret = PS_APPROVED;
             break;
-        case RLO_FAILED:
+        case PS_DENIED:
             DEBUG_PRINT
             ret = PS_DENIED;
             break;
-        case RLO_INVALID:
-            DEBUG_PRINT
-            break;
         default:
             DEBUG_PRINT
             ret = PS_DEFAULT;
@@ -98,30 +363,16 @@ int vp_check_my_proposal_state_RLO(void* vp_ctx, proposal_id pid){
 int vp_checkout_proposal_RLO(void* vp_ctx, void** prop_buf){
     assert(vp_ctx);
 
+    vp_rlo_chan* c = (vp_rlo_chan*)vp_ctx;
+    //pickup here, for all channels
+    _pool_pickup(c->pool);
 
-    RLO_engine_t* eng = (RLO_engine_t*)vp_ctx;
-    //pickup here
-    RLO_user_msg* msg_out = NULL;
-    //printf("%s:%u - rank = %d\n", __func__, __LINE__, MY_RANK_DEBUG);
-    int ret = RLO_user_pickup_next(eng, &msg_out);
-
-    if(ret){
-        assert(msg_out->data);
-        //DEBUG_PRINT
-        //printf("%s:%u, my_rank = %d, msg_out = %p, type = %d, msg_out.data = %p, data_len = %lu, data = [%p]\n",
-        //        __func__, __LINE__, MY_RANK_DEBUG, msg_out, msg_out->type, msg_out->data, msg_out->data_len, msg_out->data);
-        //
-
-        PBuf* b = NULL;//calloc(1, sizeof(PBuf));
-        pbuf_deserialize(msg_out->data + sizeof(size_t), &b);
-        //printf("%s:%u, my_rank = %d, b.pid = %d, pbuf.data_len = %lu, should be a proposal_buf size.\n",
-        //        __func__, __LINE__, MY_RANK_DEBUG, b->pid, b->data_len);
-        *prop_buf = calloc(1, b->data_len);
+    if(c->pickup_q.head){
+        Queue_node* node = c->pickup_q.head;
 
-        memcpy(*prop_buf, b->data, b->data_len);
-
-        RLO_user_msg_recycle(eng, msg_out);
-        pbuf_free(b);
+        //printf("%s:%u, my_rank = %d, channel = %d\n", __func__, __LINE__, MY_RANK_DEBUG, c->channel);
+        *prop_buf = node->data;
+        gen_queue_remove(&(c->pickup_q), node, 1);
         return 1;
     }
 
@@ -131,25 +382,30 @@ int vp_checkout_proposal_RLO(void* vp_ctx, void** prop_buf){
 
 int vp_make_progress_RLO(void* vp_ctx){
     assert(vp_ctx);
-    // RLO_engine_t* eng = (RLO_engine_t*)vp_ctx;
+    vp_rlo_chan* c = (vp_rlo_chan*)vp_ctx;
 
-    RLO_make_progress();
+    _pool_pump(c->pool);
     //DEBUG_PRINT
     return 0;
 }
 
 int vp_rm_my_proposal_RLO(void* vp_ctx){
     assert(vp_ctx);
-    //RLO_engine_t* eng = (RLO_engine_t*)vp_ctx;
-    //????
+    vp_rlo_chan* c = (vp_rlo_chan*)vp_ctx;
+
+    // Decided by now, the engine is done with the buf
+    assert(c->pool->owner != c);
+    free(c->my_buf);
+    c->my_buf = NULL;
+    c->my_state = PS_DEFAULT;
     return 0;
 }
 
 int vp_get_my_rank_RLO(void* vp_ctx){
     DEBUG_PRINT
     assert(vp_ctx);
-    RLO_engine_t* eng = (RLO_engine_t*)vp_ctx;
-    return RLO_get_eng_rank(eng);
+    vp_rlo_chan* c = (vp_rlo_chan*)vp_ctx;
+    return RLO_get_eng_rank(c->pool->eng);
 }
 // ========================== Private functions ==========================
 
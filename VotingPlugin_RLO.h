@@ -22,8 +22,53 @@ typedef struct VP_ctx_out_RLO{
 typedef struct vp_info_in_RLO{
     MPI_Comm mpi_comm;
     MPI_Info mpi_info;
+    int channel;                // From vp_reserve_channel_RLO(), or -1 to reserve one in vp_init_RLO()
 }vp_info_rlo;
 
+typedef struct vp_rlo_chan vp_rlo_chan;
+
+// One engine per communicator, shared by everything opened on it. Each
+// vp_init_RLO() on the same comm handle adds a channel, and proposals carry
+// their channel # in front so the engine's traffic can be told apart.
+typedef struct vp_rlo_pool{
+    MPI_Comm comm;              // Not owned, the engine dups its own
+    RLO_engine_t* eng;
+    int ref_cnt;                // Reserved channels
+    int next_channel;           // Same on all ranks, channels are reserved collectively in the same order
+    vp_rlo_chan* chans;
+    vp_rlo_chan* owner;         // The engine votes on one proposal of mine at a time
+    gen_queue stray_q;          // Picked up for channels with no vp_init_RLO() here yet, channel # still in front
+    struct vp_rlo_pool* next;
+}vp_rlo_pool;
+
+// What vp_init_RLO() hands out: one channel of a pooled engine.
+struct vp_rlo_chan{
+    vp_rlo_pool* pool;
+    int channel;
+    int (*judgement)(const void* prop_buf, void* app_ctx);
+    void* app_ctx;
+    gen_queue pickup_q;         // Proposal bufs picked up for this channel
+    void* my_buf;               // Channel # + my encoded proposal, until vp_rm_my_proposal_RLO()
+    size_t my_len;
+    proposal_id my_pid;
+    proposal_state my_state;    // PS_DEFAULT: waiting for the engine, PS_IN_PROGRESS: being voted on
+    vp_rlo_chan* next;
+};
+
+// Collective over comm: take the next channel #, and make the engine if
+// comm has none yet. vp_init_RLO() with it later is local, so it can wait
+// until the channel's first proposal.
+int vp_reserve_channel_RLO(MPI_Comm comm);
+// Give back a channel that never got a vp_init_RLO(), same calling rules as vp_finalize_RLO()
+int vp_release_channel_RLO(MPI_Comm comm, int channel);
+// Move comm's engine along, for waiting on a channel with no vp_init_RLO() here
+int vp_progress_RLO(MPI_Comm comm);
+
+// For plugins that run an engine of their own instead of a pooled channel:
+// plain bcast and pickup on eng, no channel # in front.
+int vp_bcast_eng_RLO(RLO_engine_t* eng, proposal* proposal_in);
+int vp_pickup_eng_RLO(RLO_engine_t* eng, void** prop_buf_out);
+
 int vp_init_RLO(int (*h5_judgement)(), void* h5ctx, void* vp_info_in, void** vp_ctx_out);
 
 int vp_finalize_RLO(void* vp_ctx);
@@ -0,0 +1,104 @@
+#include "VotingPlugin_RMA.h"
+extern int MY_RANK_DEBUG;
+
+// ========================== Private functions ==========================
+
+// Take the next global sequence # and use it as the proposal's ordering key.
+static time_stamp _fetch_next_seq(VP_ctx_rma* ctx){
+    time_stamp one = 1;
+    time_stamp seq = 0;
+
+    MPI_Fetch_and_op(&one, &seq, MPI_UNSIGNED_LONG, ctx->host_rank, 0, MPI_SUM, ctx->seq_win);
+    MPI_Win_flush(ctx->host_rank, ctx->seq_win);
+    return seq;
+}
+
+// ========================== Public functions ==========================
+
+int vp_init_RMA(int (*h5_judgement)(), void* h5ctx, void* vp_info_in, void** vp_ctx_out){
+    vp_info_rlo* vp_info = (vp_info_rlo*)vp_info_in;
+    VP_ctx_rma* ctx = calloc(1, sizeof(VP_ctx_rma));
+    MPI_Comm comm = vp_info->mpi_comm;
+    int my_rank;
+    MPI_Aint win_size;
+
+    MPI_Comm_rank(comm, &my_rank);
+    ctx->host_rank = VP_RMA_HOST_RANK;
+    ctx->my_state = PS_DEFAULT;
+
+    win_size = (my_rank == ctx->host_rank) ? sizeof(time_stamp) : 0;
+    MPI_Win_allocate(win_size, sizeof(time_stamp), vp_info->mpi_info, comm,
+            &(ctx->seq_base), &(ctx->seq_win));
+    if(my_rank == ctx->host_rank)
+        *(ctx->seq_base) = 0;
+
+    // One passive target epoch for the whole life of the file
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, ctx->seq_win);
+    MPI_Barrier(comm);// counter is zeroed before anyone fetches from it
+
+    // No votes, the judgement callback is never invoked.
+    ctx->eng = RLO_progress_engine_new(comm, RLO_MSG_SIZE_MAX, h5_judgement, h5ctx, NULL);
+    DEBUG_PRINT
+    *vp_ctx_out = (void*)ctx;
+    return 0;
+}
+
+int vp_finalize_RMA(void* vp_ctx){
+    int ret;
+    assert(vp_ctx);
+    VP_ctx_rma* ctx = (VP_ctx_rma*)vp_ctx;
+
+    ret = RLO_progress_engine_cleanup(ctx->eng);
+    assert(ret == 0);
+
+    MPI_Win_unlock_all(ctx->seq_win);
+    MPI_Win_free(&(ctx->seq_win));
+    free(ctx);
+    return 1;
+}
+
+int vp_submit_proposal_RMA(void* vp_ctx, proposal* proposal_in){
+    assert(vp_ctx && proposal_in);
+    VP_ctx_rma* ctx = (VP_ctx_rma*)vp_ctx;
+
+    // The sequence # replaces the timestamp, so the ledger's (time, pid)
+    // ordering becomes the global sequence order.
+    proposal_in->time = _fetch_next_seq(ctx);
+    vp_bcast_eng_RLO(ctx->eng, proposal_in);
+    ctx->my_state = PS_APPROVED;
+    return 0;
+}
+
+// Every proposal is sequenced, so a plain bcast gets the same treatment.
+int vp_submit_bcast_RMA(void* vp_ctx, proposal* proposal_in){
+    return vp_submit_proposal_RMA(vp_ctx, proposal_in);
+}
+
+int vp_check_my_proposal_state_RMA(void* vp_ctx, proposal_id pid){
+    assert(vp_ctx);
+    VP_ctx_rma* ctx = (VP_ctx_rma*)vp_ctx;
+
+    RLO_make_progress();
+    return ctx->my_state;
+}
+
+int vp_checkout_proposal_RMA(void* vp_ctx, void** prop_buf){
+    assert(vp_ctx);
+    VP_ctx_rma* ctx = (VP_ctx_rma*)vp_ctx;
+
+    return vp_pickup_eng_RLO(ctx->eng, prop_buf);
+}
+
+int vp_make_progress_RMA(void* vp_ctx){
+    assert(vp_ctx);
+    RLO_make_progress();
+    return 0;
+}
+
+int vp_rm_my_proposal_RMA(void* vp_ctx){
+    assert(vp_ctx);
+    VP_ctx_rma* ctx = (VP_ctx_rma*)vp_ctx;
+
+    ctx->my_state = PS_DEFAULT;
+    return 0;
+}
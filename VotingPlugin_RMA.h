@@ -0,0 +1,43 @@
+/*
+ * VotingPlugin_RMA.h
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Total order by a global sequence counter: each proposal takes the next
+ *  number with one MPI_Fetch_and_op on a window hosted by one rank, and is
+ *  then bcast through a rootless engine. No voting and no time window, the
+ *  ledger executes proposals strictly in sequence order.
+ */
+
+#ifndef VOTINGPLUGIN_RMA_H_
+#define VOTINGPLUGIN_RMA_H_
+
+#include "VotingPlugin_RLO.h"   // vp_info_rlo, bcast through the RLO engine
+
+#define VP_RMA_HOST_RANK    0   // Rank that hosts the sequence counter
+
+typedef struct VP_ctx_out_RMA{
+    RLO_engine_t* eng;          // Disseminates sequenced proposals
+    MPI_Win seq_win;
+    time_stamp* seq_base;       // Counter, only allocated on the host rank
+    int host_rank;
+    proposal_state my_state;
+}VP_ctx_rma;
+
+// vp_info_in is a vp_info_rlo, same as the RLO plugin.
+int vp_init_RMA(int (*h5_judgement)(), void* h5ctx, void* vp_info_in, void** vp_ctx_out);
+
+int vp_finalize_RMA(void* vp_ctx);
+
+int vp_submit_proposal_RMA(void* vp_ctx, proposal* proposal);
+int vp_submit_bcast_RMA(void* vp_ctx, proposal* proposal);
+
+int vp_check_my_proposal_state_RMA(void* vp_ctx, proposal_id pid);
+
+int vp_checkout_proposal_RMA(void* vp_ctx, void** prop_buf_out);
+
+int vp_rm_my_proposal_RMA(void* vp_ctx);
+
+int vp_make_progress_RMA(void* vp_ctx);
+
+#endif /* VOTINGPLUGIN_RMA_H_ */
@@ -0,0 +1,276 @@
+#include "VotingPlugin_SEQ.h"
+extern int MY_RANK_DEBUG;
+
+// Room left in an RLO message after the pbuf and size headers
+#define VP_SEQ_BATCH_MAX    (RLO_MSG_SIZE_MAX - 128)
+
+// A proposal waiting at the sequencer
+typedef struct seq_pending_entry{
+    int origin;
+    size_t len;
+    void* prop_buf;
+}seq_entry;
+
+// Batch layout: int cnt, then cnt x {int origin, int decision, size_t len, prop_buf}
+#define SEQ_ENTRY_HDR_SIZE  (sizeof(int) + sizeof(int) + sizeof(size_t))
+
+// ========================== Private functions ==========================
+
+// Apply one decision from a batch, on every rank including the sequencer.
+static void _seq_apply_decision(VP_ctx_seq* ctx, int origin, int decision, size_t len, void* prop_buf){
+    if(origin == ctx->my_rank){
+        if(ctx->my_send_req != MPI_REQUEST_NULL)
+            MPI_Wait(&(ctx->my_send_req), MPI_STATUS_IGNORE);
+        free(ctx->my_send_buf);
+        ctx->my_send_buf = NULL;
+
+        if(decision){
+            proposal* p = proposal_decoder(prop_buf);
+            // MM adds my own copy to the ledger, it must carry the sequence #.
+            ctx->my_proposal->time = p->time;
+            free(p->proposal_data);
+            free(p);
+            ctx->my_state = PS_APPROVED;
+        } else
+            ctx->my_state = PS_DENIED;
+        return;
+    }
+
+    if(decision){
+        void* buf = calloc(1, len);
+        memcpy(buf, prop_buf, len);
+        gen_queue_append(&(ctx->ready_q), gen_queue_node_new(buf));
+    }
+}
+
+static void _seq_apply_batch(VP_ctx_seq* ctx, void* batch){
+    char* cur = (char*)batch;
+    int cnt = *(int*)cur;
+    cur += sizeof(int);
+
+    for(int i = 0; i < cnt; i++){
+        int origin = *(int*)cur;
+        int decision = *(int*)(cur + sizeof(int));
+        size_t len = *(size_t*)(cur + 2 * sizeof(int));
+
+        cur += SEQ_ENTRY_HDR_SIZE;
+        _seq_apply_decision(ctx, origin, decision, len, cur);
+        cur += len;
+    }
+}
+
+static void _seq_bcast_batch(VP_ctx_seq* ctx, void* batch, size_t batch_len){
+    void* pbuf_buf = NULL;
+    size_t pbuf_len = 0;
+
+    pbuf_serialize(0, 1, 0, batch_len, batch, &pbuf_buf, &pbuf_len);
+    RLO_msg_t* bcast_msg = RLO_msg_new_bc(ctx->eng, pbuf_buf, pbuf_len);
+    RLO_bcast_gen(ctx->eng, bcast_msg, RLO_BCAST);
+    free(pbuf_buf);
+
+    // The bcast doesn't come back to me.
+    _seq_apply_batch(ctx, batch);
+}
+
+// Sequencer: receive what's been submitted so far.
+static void _seq_recv_submissions(VP_ctx_seq* ctx){
+    int flag = 1;
+    MPI_Status stat;
+
+    while(flag){
+        MPI_Iprobe(MPI_ANY_SOURCE, VP_SEQ_TAG_SUBMIT, ctx->comm, &flag, &stat);
+        if(flag){
+            int len;
+            seq_entry* e = calloc(1, sizeof(seq_entry));
+
+            MPI_Get_count(&stat, MPI_CHAR, &len);
+            e->origin = stat.MPI_SOURCE;
+            e->len = len;
+            e->prop_buf = calloc(1, len);
+            MPI_Recv(e->prop_buf, len, MPI_CHAR, stat.MPI_SOURCE, VP_SEQ_TAG_SUBMIT, ctx->comm, MPI_STATUS_IGNORE);
+            gen_queue_append(&(ctx->pending_q), gen_queue_node_new(e));
+        }
+    }
+}
+
+// Sequencer: judge everything pending in arrival order, number the approved
+// ones and send the decisions out, as few bcasts as the message size allows.
+static void _seq_decide_pending(VP_ctx_seq* ctx){
+    char* batch;
+    size_t batch_len;
+    int cnt = 0;
+
+    if(ctx->pending_q.node_cnt == 0)
+        return;
+
+    batch = calloc(1, VP_SEQ_BATCH_MAX);
+    batch_len = sizeof(int);
+    while(ctx->pending_q.head){
+        Queue_node* node = ctx->pending_q.head;
+        seq_entry* e = (seq_entry*)node->data;
+        int decision;
+
+        assert(SEQ_ENTRY_HDR_SIZE + e->len + sizeof(int) <= VP_SEQ_BATCH_MAX);
+        if(batch_len + SEQ_ENTRY_HDR_SIZE + e->len > VP_SEQ_BATCH_MAX){
+            *(int*)batch = cnt;
+            _seq_bcast_batch(ctx, batch, batch_len);
+            batch_len = sizeof(int);
+            cnt = 0;
+        }
+
+        // Judged once here, instead of by every rank. Judge on the original
+        // timestamp, then replace it with the sequence #.
+        decision = (ctx->judgement)(e->prop_buf, ctx->app_ctx);
+        if(decision)
+            proposal_buf_set_time(e->prop_buf, ctx->next_seq++);
+
+        *(int*)(batch + batch_len) = e->origin;
+        *(int*)(batch + batch_len + sizeof(int)) = decision;
+        *(size_t*)(batch + batch_len + 2 * sizeof(int)) = e->len;
+        batch_len += SEQ_ENTRY_HDR_SIZE;
+        memcpy(batch + batch_len, e->prop_buf, e->len);
+        batch_len += e->len;
+        cnt++;
+
+        free(e->prop_buf);
+        free(e);
+        gen_queue_remove(&(ctx->pending_q), node, 1);
+    }
+    *(int*)batch = cnt;
+    _seq_bcast_batch(ctx, batch, batch_len);
+    free(batch);
+}
+
+// ========================== Public functions ==========================
+
+int vp_init_SEQ(int (*h5_judgement)(), void* h5ctx, void* vp_info_in, void** vp_ctx_out){
+    vp_info_rlo* vp_info = (vp_info_rlo*)vp_info_in;
+    VP_ctx_seq* ctx = calloc(1, sizeof(VP_ctx_seq));
+
+    ctx->comm = vp_info->mpi_comm;
+    MPI_Comm_rank(ctx->comm, &(ctx->my_rank));
+    ctx->sequencer = VP_SEQ_SEQUENCER_RANK;
+    ctx->judgement = h5_judgement;
+    ctx->app_ctx = h5ctx;
+    ctx->my_state = PS_DEFAULT;
+    ctx->my_send_req = MPI_REQUEST_NULL;
+    ctx->next_seq = 0;
+    gen_queue_init(&(ctx->ready_q));
+    gen_queue_init(&(ctx->pending_q));
+
+    // Judgement runs in this plugin, never in the engine.
+    ctx->eng = RLO_progress_engine_new(ctx->comm, RLO_MSG_SIZE_MAX, h5_judgement, h5ctx, NULL);
+    DEBUG_PRINT
+    *vp_ctx_out = (void*)ctx;
+    return 0;
+}
+
+int vp_finalize_SEQ(void* vp_ctx){
+    int ret;
+    assert(vp_ctx);
+    VP_ctx_seq* ctx = (VP_ctx_seq*)vp_ctx;
+
+    ret = RLO_progress_engine_cleanup(ctx->eng);
+    assert(ret == 0);
+    assert(ctx->pending_q.node_cnt == 0);
+    while(ctx->ready_q.head){
+        Queue_node* node = ctx->ready_q.head;
+        gen_queue_remove(&(ctx->ready_q), node, 0);
+        gen_queue_node_delete(node);
+    }
+    free(ctx);
+    return 1;
+}
+
+int vp_submit_proposal_SEQ(void* vp_ctx, proposal* proposal_in){
+    assert(vp_ctx && proposal_in);
+    VP_ctx_seq* ctx = (VP_ctx_seq*)vp_ctx;
+    void* proposal_buf = NULL;
+    size_t prop_total_size;
+
+    assert(ctx->my_state != PS_IN_PROGRESS);
+    prop_total_size = proposal_encoder(proposal_in, &proposal_buf);
+    ctx->my_proposal = proposal_in;
+    ctx->my_state = PS_IN_PROGRESS;
+
+    if(ctx->my_rank == ctx->sequencer){
+        seq_entry* e = calloc(1, sizeof(seq_entry));
+        e->origin = ctx->my_rank;
+        e->len = prop_total_size;
+        e->prop_buf = proposal_buf;
+        gen_queue_append(&(ctx->pending_q), gen_queue_node_new(e));
+    } else {
+        ctx->my_send_buf = proposal_buf;
+        MPI_Isend(proposal_buf, prop_total_size, MPI_CHAR, ctx->sequencer,
+                VP_SEQ_TAG_SUBMIT, ctx->comm, &(ctx->my_send_req));
+    }
+
+    vp_make_progress_SEQ(ctx);
+    return 0;
+}
+
+// The sequence # is only known once the sequencer has answered, and the
+// caller stamps its local copy right after this returns, so wait for it.
+int vp_submit_bcast_SEQ(void* vp_ctx, proposal* proposal_in){
+    assert(vp_ctx && proposal_in);
+    VP_ctx_seq* ctx = (VP_ctx_seq*)vp_ctx;
+
+    vp_submit_proposal_SEQ(ctx, proposal_in);
+    while(ctx->my_state == PS_IN_PROGRESS)
+        vp_make_progress_SEQ(ctx);
+    return 0;
+}
+
+int vp_check_my_proposal_state_SEQ(void* vp_ctx, proposal_id pid){
+    assert(vp_ctx);
+    VP_ctx_seq* ctx = (VP_ctx_seq*)vp_ctx;
+
+    vp_make_progress_SEQ(ctx);
+    return ctx->my_state;
+}
+
+int vp_checkout_proposal_SEQ(void* vp_ctx, void** prop_buf){
+    assert(vp_ctx);
+    VP_ctx_seq* ctx = (VP_ctx_seq*)vp_ctx;
+    Queue_node* node;
+
+    if(!ctx->ready_q.head)
+        vp_make_progress_SEQ(ctx);
+
+    node = ctx->ready_q.head;
+    if(node){
+        *prop_buf = node->data;
+        gen_queue_remove(&(ctx->ready_q), node, 1);
+        return 1;
+    }
+    return 0;
+}
+
+int vp_make_progress_SEQ(void* vp_ctx){
+    assert(vp_ctx);
+    VP_ctx_seq* ctx = (VP_ctx_seq*)vp_ctx;
+    void* batch = NULL;
+
+    RLO_make_progress();
+
+    if(ctx->my_rank == ctx->sequencer){
+        _seq_recv_submissions(ctx);
+        _seq_decide_pending(ctx);
+    } else {
+        while(vp_pickup_eng_RLO(ctx->eng, &batch)){
+            _seq_apply_batch(ctx, batch);
+            free(batch);
+            batch = NULL;
+        }
+    }
+    return 0;
+}
+
+int vp_rm_my_proposal_SEQ(void* vp_ctx){
+    assert(vp_ctx);
+    VP_ctx_seq* ctx = (VP_ctx_seq*)vp_ctx;
+
+    ctx->my_proposal = NULL;
+    ctx->my_state = PS_DEFAULT;
+    return 0;
+}
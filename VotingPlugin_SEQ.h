@@ -0,0 +1,58 @@
+/*
+ * VotingPlugin_SEQ.h
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Centralized sequencer: every rank sends its proposal to one sequencer
+ *  rank, which runs the judgement once per proposal, numbers the approved
+ *  ones and bcasts the decisions back in batches over the rootless engine.
+ *  Cheaper than skip-ring voting plus a time window for small/medium jobs.
+ */
+
+#ifndef VOTINGPLUGIN_SEQ_H_
+#define VOTINGPLUGIN_SEQ_H_
+
+#include "VotingPlugin_RLO.h"   // vp_info_rlo, bcast through the RLO engine
+
+#define VP_SEQ_SEQUENCER_RANK   0
+#define VP_SEQ_TAG_SUBMIT       10  // Proposal to the sequencer, on vp_info's comm
+
+typedef struct VP_ctx_out_SEQ{
+    RLO_engine_t* eng;          // Bcasts decision batches
+    MPI_Comm comm;              // Proposals to the sequencer, not owned
+    int my_rank;
+    int sequencer;
+    int (*judgement)(const void* prop_buf, void* app_ctx);
+    void* app_ctx;
+
+    /* My own, at most one in flight */
+    proposal* my_proposal;      // Restamped with its sequence # when approved
+    proposal_state my_state;
+    void* my_send_buf;
+    MPI_Request my_send_req;
+
+    /* Approved proposal bufs from others, ready for checkout */
+    gen_queue ready_q;
+
+    /* Sequencer only */
+    gen_queue pending_q;        // Submitted, not decided yet, arrival order
+    time_stamp next_seq;
+}VP_ctx_seq;
+
+// vp_info_in is a vp_info_rlo, same as the RLO plugin.
+int vp_init_SEQ(int (*h5_judgement)(), void* h5ctx, void* vp_info_in, void** vp_ctx_out);
+
+int vp_finalize_SEQ(void* vp_ctx);
+
+int vp_submit_proposal_SEQ(void* vp_ctx, proposal* proposal);
+int vp_submit_bcast_SEQ(void* vp_ctx, proposal* proposal);
+
+int vp_check_my_proposal_state_SEQ(void* vp_ctx, proposal_id pid);
+
+int vp_checkout_proposal_SEQ(void* vp_ctx, void** prop_buf_out);
+
+int vp_rm_my_proposal_SEQ(void* vp_ctx);
+
+int vp_make_progress_SEQ(void* vp_ctx);
+
+#endif /* VOTINGPLUGIN_SEQ_H_ */
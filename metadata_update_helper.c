@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <string.h>
+#include <limits.h>
 #include <sys/time.h>
 
 #include "metadata_update_helper.h"
@@ -17,6 +18,11 @@ extern int MY_RANK_DEBUG;
 
 void _checkout_proposal_make_progress(metadata_manager* mm);
 int MM_ledger_process(metadata_manager* mm);
+int _ledger_sequence_process(metadata_manager* mm);
+int _epoch_make_progress(metadata_manager* mm);
+int _async_make_progress(metadata_manager* mm);
+int _ledger_depends_process(metadata_manager* mm);
+static int _mm_judgement(const void* prop_buf, void* ctx);
 
 metadata_manager* MM_metadata_update_helper_init(int mode, int world_size, unsigned long time_window_size,
         int (*h5_namespace_judgement)(), void* app_ctx, VotingPlugin* vp,
@@ -28,11 +34,18 @@ metadata_manager* MM_metadata_update_helper_init(int mode, int world_size, unsig
     mm->mode = mode;
     mm->world_size = world_size;
     mm->time_window_size = time_window_size;
-
-    mm->vm = VM_voting_manager_init(vp, h5_namespace_judgement, app_ctx);
+    mm->order = vp->order;
+    mm->next_seq = 0;
+    gen_queue_init(&(mm->async_q));
+    mm->depends_cb = NULL;
+    mm->judgement = h5_namespace_judgement;
+    gen_queue_init(&(mm->judged_q));
+
+    mm->vm = VM_voting_manager_init(vp, &_mm_judgement, mm);
     //printf("%s:%d:mode = %d, world_size = %d, window size =  %d\n", __func__, __LINE__, mode, world_size, time_window_size);
-    _checkout_proposal_make_progress(mm);
     mm->lm = LM_ledger_manager_init();
+    // A pooled engine may have picked up proposals for us already
+    _checkout_proposal_make_progress(mm);
     //DEBUG_PRINT
     mm->em = EM_execution_manager_init(cb_execute, app_ctx);
     DEBUG_PRINT
@@ -48,17 +61,72 @@ int MM_metadata_update_helper_term(metadata_manager* mm){
 //    EM_execute_all(mm->em);
     DEBUG_PRINT
 
+    if(mm->epoch){
+        if(!mm->epoch->done)
+            MM_epoch_finish(mm);
+        free(mm->epoch);
+    }
     VM_voting_manager_term(mm->vm);
     LM_ledger_manager_term(mm->lm);
     EM_execution_manager_term(mm->em);
+    if(mm->clk)
+        clk_sync_term(mm->clk);
+    while(mm->judged_q.head)
+        gen_queue_remove(&(mm->judged_q), mm->judged_q.head, 1);
+    free(mm->seen_time);
     return -1;
 }
 
+// What's voted on here, for the depends order: approved ones are pending
+// until they're in the ledger. Time and pid are its first fields.
+typedef struct dep_judged{
+    time_stamp time;
+    proposal_id pid;
+    int op_type;
+    proposal_key key;
+}dep_judged;
+
+static void _dep_judged_drop(metadata_manager* mm, proposal_id pid, time_stamp time){
+    for(Queue_node* cur = mm->judged_q.head; cur; cur = cur->next)
+        if(((dep_judged*)(cur->data))->pid == pid && ((dep_judged*)(cur->data))->time == time){
+            gen_queue_remove(&(mm->judged_q), cur, 1);
+            return;
+        }
+}
+
+// The app's judgement, noting what's been voted on for the depends order
+static int _mm_judgement(const void* prop_buf, void* ctx){
+    metadata_manager* mm = (metadata_manager*)ctx;
+    int ret = (mm->judgement)(prop_buf, mm->app_ctx);
+    proposal_id pid;
+    time_stamp time;
+
+    if(!mm->depends_cb)
+        return ret;
+    pid = ((const proposal*)prop_buf)->pid;
+    if(pid == mm->my_rank)// Mine are known here without it
+        return ret;
+    time = ((const proposal*)prop_buf)->time;
+    if(pid >= 0 && pid < mm->world_size && time > mm->seen_time[pid])
+        mm->seen_time[pid] = time;
+    if(ret){// May be approved: until it's here, later ones that depend on it wait
+        dep_judged* j = calloc(1, sizeof(dep_judged));
+
+        j->time = time;
+        j->pid = pid;
+        proposal_buf_key((void*)prop_buf, &(j->op_type), &(j->key));
+        gen_queue_append(&(mm->judged_q), gen_queue_node_new(j));
+    }
+    return ret;
+}
+
 void _checkout_proposal_make_progress(metadata_manager* mm){
     void* new_proposal_buf = NULL;
     while(VM_checkout_proposal(mm->vm, &new_proposal_buf)){//newly received an approved proposal_buf
         //DEBUG_PRINT
         assert(new_proposal_buf);
+        if(mm->depends_cb)
+            _dep_judged_drop(mm, ((proposal*)new_proposal_buf)->pid, ((proposal*)new_proposal_buf)->time);
         Queue_node* new_node = gen_queue_node_new(new_proposal_buf);
         LM_add_ledger(mm->lm, new_node);
         //printf("%s:%d: rank = %d,  checked out: pid = %d, ledger_cnt = %d, pp_time = %lu, now = %lu\n",
@@ -74,15 +142,170 @@ MM_make_progress_cb(Queue_node *node, void *ctx)
     time_stamp prop_time = ((proposal*)(node->data))->time;
     time_stamp now;
 
-    now = MM_get_time_stamp_us();
-    if((now - prop_time) > mm->time_window_size) {
+    now = MM_get_global_time_us(mm);
+    if(now > prop_time && (now - prop_time) > mm->time_window_size) {
+        LM_remove_ledger(mm->lm, node);
+        EM_add_proposal(mm->em, node);
+    }
+
+    return 0;
+}
+
+int
+MM_sequence_cb(Queue_node *node, void *ctx)
+{
+    metadata_manager *mm = (metadata_manager *)ctx;
+    time_stamp prop_seq = ((proposal*)(node->data))->time;
+
+    if(prop_seq == mm->next_seq) {
         LM_remove_ledger(mm->lm, node);
         EM_add_proposal(mm->em, node);
+        mm->next_seq++;
     }
 
     return 0;
 }
 
+// For VP_ORDER_SEQUENCE: move the gap-free run of sequence #s starting at
+// next_seq to the execution queue, leave the rest until the gap is filled.
+// Returns # of proposals moved.
+int _ledger_sequence_process(metadata_manager* mm)
+{
+    time_stamp start_seq = mm->next_seq;
+    time_stamp pass_seq;
+
+    do {
+        pass_seq = mm->next_seq;
+        LM_iterate(mm->lm, MM_sequence_cb, mm);
+    } while(mm->next_seq != pass_seq && LM_ledger_cnt(mm->lm) > 0);
+
+    return (int)(mm->next_seq - start_seq);
+}
+
+typedef struct ledger_dep_rec{
+    time_stamp time;
+    proposal_id pid;
+    int op_type;
+    proposal_key key;
+    int held;//left in the ledger, later ones may have to wait for it
+    Queue_node* node;
+}ledger_dep_rec;
+
+static int _dep_rec_cmp(const void* a, const void* b){
+    const ledger_dep_rec* ra = a;
+    const ledger_dep_rec* rb = b;
+    if(ra->time != rb->time)
+        return ra->time < rb->time ? -1 : 1;
+    return ra->pid < rb->pid ? -1 : (ra->pid > rb->pid);
+}
+
+// Whether an older proposal judged here but not in the ledger yet may
+// still come and have to run before rec
+static int _dep_judged_before(metadata_manager* mm, const ledger_dep_rec* rec){
+    for(Queue_node* cur = mm->judged_q.head; cur; cur = cur->next){
+        dep_judged* j = (dep_judged*)(cur->data);
+
+        if((j->time < rec->time || (j->time == rec->time && j->pid < rec->pid))
+                && (mm->depends_cb)(j->op_type, j->key, rec->op_type, rec->key))
+            return 1;
+    }
+    return 0;
+}
+
+// With a depends_cb: in (time, pid) order, move each ledger proposal that
+// doesn't depend on an older one still held here, on an older one of mine
+// still being voted on, or on an older one voted on here and not arrived
+// yet. And only once every other rank has had a newer proposal voted on
+// here, else an older one of theirs may still be on its way: then it waits
+// out the window. Returns # of proposals moved.
+int _ledger_depends_process(metadata_manager* mm)
+{
+    int cnt = LM_ledger_cnt(mm->lm);
+    int n = 0, moved = 0;
+    ledger_dep_rec* recs;
+    Queue_node* cur;
+    time_stamp now = MM_get_global_time_us(mm);
+    time_stamp seen = ULONG_MAX;
+
+    // Approved ones got here within their window, the rest were voted down
+    for(cur = mm->judged_q.head; cur; ){
+        Queue_node* next = cur->next;
+        time_stamp t = ((dep_judged*)(cur->data))->time;
+
+        if(now > t && (now - t) > mm->time_window_size)
+            gen_queue_remove(&(mm->judged_q), cur, 1);
+        cur = next;
+    }
+    for(int r = 0; r < mm->world_size; r++)
+        if(r != mm->my_rank && mm->seen_time[r] < seen)
+            seen = mm->seen_time[r];
+
+    if(cnt == 0)
+        return 0;
+    recs = calloc(cnt, sizeof(ledger_dep_rec));
+    for(cur = mm->lm->ledger_q.head; cur && n < cnt; cur = cur->next, n++) {
+        recs[n].time = ((proposal*)(cur->data))->time;
+        recs[n].pid = ((proposal*)(cur->data))->pid;
+        proposal_buf_key(cur->data, &(recs[n].op_type), &(recs[n].key));
+        recs[n].node = cur;
+    }
+    qsort(recs, n, sizeof(ledger_dep_rec), _dep_rec_cmp);
+
+    for(int i = 0; i < n; i++) {
+        if(seen < recs[i].time || _dep_judged_before(mm, &recs[i]))
+            recs[i].held = 1;
+        for(int j = 0; j < i && !recs[i].held; j++)
+            if(recs[j].held && (mm->depends_cb)(recs[j].op_type, recs[j].key, recs[i].op_type, recs[i].key))
+                recs[i].held = 1;
+        for(cur = mm->async_q.head; cur && !recs[i].held; cur = cur->next) {
+            proposal* mine = ((mm_async_op*)(cur->data))->p;
+
+            if(((mm_async_op*)(cur->data))->state == PS_IN_PROGRESS
+                    && (mine->time < recs[i].time || (mine->time == recs[i].time && mine->pid < recs[i].pid))
+                    && (mm->depends_cb)(mine->op_type, mine->parent_key, recs[i].op_type, recs[i].key))
+                recs[i].held = 1;
+        }
+        if(!recs[i].held) {
+            LM_remove_ledger(mm->lm, recs[i].node);
+            EM_add_proposal(mm->em, recs[i].node);
+            moved++;
+            mm->early++;
+        }
+    }
+    free(recs);
+    return moved;
+}
+
+int MM_set_depends_cb(metadata_manager* mm, int my_rank,
+        int (*depends_cb)(int op_old, proposal_key key_old, int op_new, proposal_key key_new)){
+    assert(mm && my_rank >= 0 && my_rank < mm->world_size);
+    mm->my_rank = my_rank;
+    if(!mm->seen_time)
+        mm->seen_time = calloc(mm->world_size, sizeof(time_stamp));
+    mm->depends_cb = depends_cb;
+    return 0;
+}
+
+// Time for a proposal of mine about to be voted on. With a depends_cb they
+// must go out in increasing time order, see _ledger_depends_process(), even
+// if the clock offset moves back, and with my rank as their pid.
+static void _stamp_mine(metadata_manager* mm, proposal* p){
+    p->time = MM_get_global_time_us(mm);
+    if(!mm->depends_cb)
+        return;
+    if(p->time <= mm->last_time)
+        p->time = mm->last_time + 1;
+    mm->last_time = p->time;
+    p->pid = mm->my_rank;
+}
+
+static int _ledger_has(ledger_mgr* lm, Queue_node* node){
+    for(Queue_node* cur = lm->ledger_q.head; cur; cur = cur->next)
+        if(cur == node)
+            return 1;
+    return 0;
+}
+
 // Make progress through all queues, obeying time window "age out", but not
 // blocking
 int
@@ -93,14 +316,28 @@ MM_make_progress(metadata_manager *mm)
     assert(mm);
 
     // Push things along in lower levels, possibly adding proposals to ledger
+    if(mm->clk)
+        clk_sync_make_progress(mm->clk);
+    if(mm->epoch)
+        _epoch_make_progress(mm);
     VM_voting_make_progress(mm->vm);
     _checkout_proposal_make_progress(mm);
+    if(mm->async_q.head)
+        _async_make_progress(mm);
 
     // Check for proposales in ledger, moving aged out ones to the
     // execution queue (in the callback)
     q_cnt = LM_ledger_cnt(mm->lm);
-    if(q_cnt > 0)
-        LM_iterate(mm->lm, MM_make_progress_cb, mm);
+    if(q_cnt > 0) {
+        if(mm->order == VP_ORDER_SEQUENCE)
+            _ledger_sequence_process(mm);
+        else {
+            LM_iterate(mm->lm, MM_make_progress_cb, mm);
+            // Then whatever doesn't have to wait for the rest
+            if(mm->depends_cb && mm->mode == 1)
+                _ledger_depends_process(mm);
+        }
+    }
 
     // Check for proposales to execute and if there are any, do so
     // (EM_execute_all() does so in the correct time order)
@@ -118,9 +355,21 @@ int MM_ledger_process(metadata_manager* mm)
     int ledger_cnt;
 
     assert(mm);
+    if(mm->clk)
+        clk_sync_make_progress(mm->clk);
     VM_voting_make_progress(mm->vm);
     _checkout_proposal_make_progress(mm);
     ledger_cnt = LM_ledger_cnt(mm->lm);
+    if(mm->order == VP_ORDER_SEQUENCE) {
+        // Nothing ages out, wait for the gaps to be filled instead.
+        while(ledger_cnt > 0) {
+            _ledger_sequence_process(mm);
+            VM_voting_make_progress(mm->vm);
+            _checkout_proposal_make_progress(mm);
+            ledger_cnt = LM_ledger_cnt(mm->lm);
+        }
+        return -1;
+    }
     while(ledger_cnt > 0) {
         time_stamp pp_time = 0;
 
@@ -129,8 +378,8 @@ int MM_ledger_process(metadata_manager* mm)
         //         ledger_cnt);
 
         Queue_node* old_pp = LM_get_oldest_record(mm->lm, &pp_time);
-        time_stamp now = MM_get_time_stamp_us();
-        if((now - pp_time) > mm->time_window_size){
+        time_stamp now = MM_get_global_time_us(mm);
+        if(now > pp_time && (now - pp_time) > mm->time_window_size){
             LM_remove_ledger(mm->lm, old_pp);
             EM_add_proposal(mm->em, old_pp);
 
@@ -180,11 +429,18 @@ int MM_submit_proposal(metadata_manager* mm, proposal* p){
     assert(mm && p);
     int ret = -1;
     p->isLocal = 0;
+    // Stamp in the reference timebase, so other ranks judge its age correctly.
+    p->time = MM_get_global_time_us(mm);
     DEBUG_PRINT
     if(mm->mode == 1){//regular mode
         DEBUG_PRINT
+        // The voting plugin tracks one proposal of mine at a time
+        while(mm->async_q.head)
+            MM_make_progress(mm);
+        _stamp_mine(mm, p);
         //encoding proposal and send over network in this call.
         ret = VM_submit_proposal_for_voting(mm->vm, p);
+        mm->voted++;
         proposal_id pid = p->pid;
 
         proposal_state my_ps = PS_IN_PROGRESS;
@@ -201,16 +457,39 @@ int MM_submit_proposal(metadata_manager* mm, proposal* p){
             proposal_encoder(p, &local_prop_buf);
             Queue_node* my_node = gen_queue_node_new(local_prop_buf);
             LM_add_ledger(mm->lm, my_node);
+            mm->ledgered++;
 
-            // Wait for this proposal to age long enough
-            while((MM_get_time_stamp_us() - p->time) < mm->time_window_size){
+            // Wait for everything sequenced before this one, then it runs
+            // right away: no window to wait out.
+            if(mm->order == VP_ORDER_SEQUENCE) {
+                while(mm->next_seq <= p->time)
+                    MM_make_progress(mm);
+            }
+
+            // Partial order: mine runs once nothing it depends on is left
+            // ahead of it, other ranks' unrelated proposals can wait.
+            if(mm->order == VP_ORDER_TIME_WINDOW && mm->depends_cb) {
+                while(_ledger_has(mm->lm, my_node))
+                    MM_make_progress(mm);
+            }
+
+            // Wait for this proposal to age long enough. If the clock offset
+            // moved back past its time, that's not long enough either.
+            while(mm->order == VP_ORDER_TIME_WINDOW && !mm->depends_cb){
+                time_stamp now = MM_get_global_time_us(mm);
+
+                if(now > p->time && (now - p->time) >= mm->time_window_size)
+                    break;
+                if(mm->clk)
+                    clk_sync_make_progress(mm->clk);
                 VM_voting_make_progress(mm->vm);
                 _checkout_proposal_make_progress(mm);
                 //MM_ledger_process(mm);
             }
         }
         DEBUG_PRINT
-        MM_ledger_process(mm);
+        if(!mm->depends_cb || mm->order != VP_ORDER_TIME_WINDOW)
+            MM_ledger_process(mm);
         //printf("%s:%d: my rank = %d Counting qs: ledg_cnt = %d, exe_cnt = %d, now = %lu\n",
         //        __func__, __LINE__, MY_RANK_DEBUG, mm->lm->ledger_q.node_cnt, mm->em->execution_q.node_cnt,
         //    MM_get_time_stamp_us());
@@ -227,8 +506,9 @@ int MM_submit_proposal(metadata_manager* mm, proposal* p){
         //DEBUG_PRINT
     } else if(mm->mode == 2){
         DEBUG_PRINT
-        //bcast proposal
-        VM_submit_bcast(mm->vm, p);
+        //bcast proposal, unless the plugin can't carry it
+        if(VM_submit_bcast(mm->vm, p) < 0)
+            return 0;
         void* local_prop_buf = NULL;
         DEBUG_PRINT
         VM_voting_make_progress(mm->vm);//make progress on RLO
@@ -236,6 +516,7 @@ int MM_submit_proposal(metadata_manager* mm, proposal* p){
         proposal_encoder(p, &local_prop_buf);
         Queue_node* my_node = gen_queue_node_new(local_prop_buf);
         LM_add_ledger(mm->lm, my_node);
+        mm->ledgered++;
         DEBUG_PRINT
 #ifdef OLD_WAY
         int lg_cnt = LM_ledger_cnt(mm->lm);
@@ -258,12 +539,317 @@ int MM_submit_proposal(metadata_manager* mm, proposal* p){
         MM_make_progress(mm);
 #endif /* OLD_WAY */
         ret = 1;
+    } else if(mm->mode == 3){
+        epoch_exchange* ep = mm->epoch;
+        void* prop_buf = NULL;
+        size_t len;
+
+        assert(ep && !ep->closing);
+        // Goes out as remote, the copy coming back to me is flipped to local.
+        len = proposal_encoder(p, &prop_buf);
+        gen_queue_append(&(ep->buf_q), gen_queue_node_new(prop_buf));
+        ep->buf_len += sizeof(size_t) + len;
+        ep->submitted++;
+
+        MM_make_progress(mm);
+        ret = 1;//executed later, at the end of its epoch
     }
     DEBUG_PRINT
     return ret;
 }
 
 
+// Vote on the async proposals one at a time, in submission order. An
+// approved one goes to the ledger like a blocking submit's would, and gets
+// executed by MM_make_progress() once it's old enough (or its turn comes).
+int _async_make_progress(metadata_manager* mm){
+    while(mm->async_q.head){
+        Queue_node* node = mm->async_q.head;
+        mm_async_op* op = (mm_async_op*)node->data;
+        proposal_state ps;
+
+        if(op->state == PS_DEFAULT){
+            op->p->isLocal = 0;
+            _stamp_mine(mm, op->p);
+            VM_submit_proposal_for_voting(mm->vm, op->p);
+            mm->voted++;
+            op->state = PS_IN_PROGRESS;
+        }
+
+        ps = VM_check_my_proposal_state(mm->vm, op->p->pid);
+        if(ps == PS_IN_PROGRESS)
+            break;
+
+        if(ps == PS_APPROVED){
+            void* local_prop_buf = NULL;
+
+            op->p->isLocal = 1;
+            proposal_encoder(op->p, &local_prop_buf);
+            LM_add_ledger(mm->lm, gen_queue_node_new(local_prop_buf));
+            mm->ledgered++;
+        }
+        VM_rm_my_proposal(mm->vm);
+        gen_queue_remove(&(mm->async_q), node, 1);
+        op->state = (ps == PS_APPROVED) ? PS_APPROVED : PS_DENIED;
+    }
+    return 0;
+}
+
+int MM_submit_announce(metadata_manager* mm, proposal* p){
+    void* local_prop_buf = NULL;
+    Queue_node* my_node;
+
+    assert(mm && p);
+    // Not voted on, so the depends order couldn't tell it's on its way
+    if(mm->mode != 1 || mm->order != VP_ORDER_TIME_WINDOW || mm->depends_cb)
+        return MM_submit_proposal(mm, p);
+
+    // Keep my own order: async ones submitted before this go first
+    while(mm->async_q.head)
+        MM_make_progress(mm);
+
+    p->isLocal = 0;
+    p->time = MM_get_global_time_us(mm);
+    VM_submit_bcast(mm->vm, p);
+    mm->announced++;
+
+    // The bcast doesn't come back to me, ledger my own copy
+    p->isLocal = 1;
+    proposal_encoder(p, &local_prop_buf);
+    my_node = gen_queue_node_new(local_prop_buf);
+    LM_add_ledger(mm->lm, my_node);
+    mm->ledgered++;
+    while(_ledger_has(mm->lm, my_node))
+        MM_make_progress(mm);
+    return 1;
+}
+
+int MM_submit_proposal_async(metadata_manager* mm, proposal* p, mm_async_op* op){
+    assert(mm && p && op);
+    assert(mm->mode == 1);
+
+    op->p = p;
+    op->state = PS_DEFAULT;
+    gen_queue_append(&(mm->async_q), gen_queue_node_new(op));
+    MM_make_progress(mm);
+    return 0;
+}
+
+int MM_withdraw_async(metadata_manager* mm, mm_async_op* op){
+    assert(mm && op);
+    if(op->state != PS_DEFAULT)
+        return 0;
+    for(Queue_node* node = mm->async_q.head; node; node = node->next){
+        if(node->data == op){
+            gen_queue_remove(&(mm->async_q), node, 1);
+            op->state = PS_DENIED;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int MM_epoch_init(metadata_manager* mm, MPI_Comm comm, unsigned int max_cnt, time_stamp interval_us){
+    epoch_exchange* ep;
+
+    assert(mm && mm->mode == 3 && !mm->epoch);
+    ep = calloc(1, sizeof(epoch_exchange));
+    ep->comm = comm;
+    MPI_Comm_rank(comm, &(ep->my_rank));
+    MPI_Comm_size(comm, &(ep->comm_size));
+    ep->max_cnt = max_cnt;
+    ep->interval_us = interval_us;
+    gen_queue_init(&(ep->buf_q));
+    ep->start_us = MM_get_time_stamp_us();
+    ep->phase = EPOCH_IDLE;
+    ep->req = MPI_REQUEST_NULL;
+    mm->epoch = ep;
+    return 0;
+}
+
+// Close the buffering epoch: pack it as {size_t len, buf} entries and post
+// the header exchange. Every rank posts every epoch, empty or not, so the
+// collectives always match up.
+static void _epoch_start(epoch_exchange* ep){
+    char* cur;
+
+    assert(ep->phase == EPOCH_IDLE);
+    assert(ep->buf_len <= INT_MAX);
+    ep->send_buf = calloc(1, ep->buf_len + 1);
+    cur = ep->send_buf;
+    while(ep->buf_q.head){
+        Queue_node* node = ep->buf_q.head;
+        size_t len = proposal_buf_size(node->data);
+
+        *(size_t*)cur = len;
+        memcpy(cur + sizeof(size_t), node->data, len);
+        cur += sizeof(size_t) + len;
+        gen_queue_remove(&(ep->buf_q), node, 0);
+        gen_queue_node_delete(node);
+    }
+    assert((size_t)(cur - ep->send_buf) == ep->buf_len);
+
+    ep->my_hdr[0] = ep->buf_len;
+    ep->my_hdr[1] = ep->closing;
+    ep->all_hdr = calloc(2 * ep->comm_size, sizeof(unsigned long));
+    MPI_Iallgather(ep->my_hdr, 2, MPI_UNSIGNED_LONG, ep->all_hdr, 2, MPI_UNSIGNED_LONG,
+            ep->comm, &(ep->req));
+    ep->phase = EPOCH_SIZES;
+    ep->buf_len = 0;
+    ep->force = 0;
+    ep->start_us = MM_get_time_stamp_us();
+}
+
+static void _epoch_post_data(epoch_exchange* ep){
+    size_t total = 0;
+
+    ep->recv_cnts = calloc(ep->comm_size, sizeof(int));
+    ep->displs = calloc(ep->comm_size, sizeof(int));
+    for(int i = 0; i < ep->comm_size; i++){
+        ep->recv_cnts[i] = (int)ep->all_hdr[2 * i];
+        ep->displs[i] = (int)total;
+        total += ep->all_hdr[2 * i];
+    }
+    assert(total <= INT_MAX);
+    ep->recv_buf = calloc(1, total + 1);
+    MPI_Iallgatherv(ep->send_buf, (int)ep->my_hdr[0], MPI_CHAR,
+            ep->recv_buf, ep->recv_cnts, ep->displs, MPI_CHAR, ep->comm, &(ep->req));
+    ep->phase = EPOCH_DATA;
+}
+
+// Everyone holds the same buffer: run it in rank order, each rank's
+// proposals in the order they were submitted. No judgement, no time window.
+static void _epoch_execute(metadata_manager* mm){
+    epoch_exchange* ep = mm->epoch;
+    int all_closing = 1;
+    int cnt = 0;
+    void** bufs = NULL;
+
+    for(int pass = 0; pass < 2; pass++){
+        if(pass == 1)
+            bufs = calloc(cnt + 1, sizeof(void*));
+        cnt = 0;
+        for(int i = 0; i < ep->comm_size; i++){
+            char* cur = ep->recv_buf + ep->displs[i];
+            char* end = cur + ep->recv_cnts[i];
+
+            while(cur < end){
+                size_t len = *(size_t*)cur;
+                void* prop_buf = cur + sizeof(size_t);
+
+                if(pass == 1){
+                    if(i == ep->my_rank){
+                        proposal_buf_set_local(prop_buf, 1);
+                        ep->executed++;
+                    }
+                    bufs[cnt] = prop_buf;
+                }
+                cnt++;
+                cur += sizeof(size_t) + len;
+            }
+            if(pass == 1 && !ep->all_hdr[2 * i + 1])
+                all_closing = 0;
+        }
+    }
+    EM_execute_batch(mm->em, bufs, cnt);
+    free(bufs);
+
+    free(ep->send_buf);
+    free(ep->recv_buf);
+    free(ep->all_hdr);
+    free(ep->recv_cnts);
+    free(ep->displs);
+    ep->send_buf = ep->recv_buf = NULL;
+    ep->all_hdr = NULL;
+    ep->recv_cnts = ep->displs = NULL;
+    ep->phase = EPOCH_IDLE;
+    ep->epoch_cnt++;
+    if(all_closing)
+        ep->done = 1;
+}
+
+// Non-blocking: advance the exchange in flight, or end the buffering epoch
+// when it's full, old enough, or forced.
+int _epoch_make_progress(metadata_manager* mm){
+    epoch_exchange* ep = mm->epoch;
+    int flag;
+
+    assert(ep);
+    while(!ep->done){
+        if(ep->phase == EPOCH_IDLE){
+            if(ep->force || ep->closing || ep->buf_q.node_cnt >= ep->max_cnt
+                    || (MM_get_time_stamp_us() - ep->start_us) >= ep->interval_us)
+                _epoch_start(ep);
+            else
+                break;
+        }
+
+        flag = 0;
+        MPI_Test(&(ep->req), &flag, MPI_STATUS_IGNORE);
+        if(!flag)
+            break;
+
+        if(ep->phase == EPOCH_SIZES)
+            _epoch_post_data(ep);
+        else {
+            _epoch_execute(mm);
+            break;// Let the caller look at the results before the next one
+        }
+    }
+    return 0;
+}
+
+int MM_epoch_wait(metadata_manager* mm){
+    epoch_exchange* ep;
+
+    assert(mm && mm->epoch);
+    ep = mm->epoch;
+    while(ep->executed < ep->submitted){
+        if(ep->phase == EPOCH_IDLE && ep->buf_q.node_cnt > 0)
+            ep->force = 1;
+        MM_make_progress(mm);
+    }
+    return 0;
+}
+
+int MM_epoch_finish(metadata_manager* mm){
+    epoch_exchange* ep;
+
+    assert(mm && mm->epoch);
+    ep = mm->epoch;
+    ep->closing = 1;
+    while(!ep->done)
+        MM_make_progress(mm);
+    assert(ep->executed == ep->submitted);
+    return 0;
+}
+
+int MM_close(metadata_manager* mm, MPI_Comm comm){
+    unsigned long total = 0;
+    MPI_Request req;
+    int done = 0;
+
+    assert(mm);
+    if(mm->epoch)
+        return MM_epoch_finish(mm);
+
+    // My count is final once my async proposals are decided
+    while(mm->async_q.head)
+        MM_make_progress(mm);
+
+    // Keep voting and executing while the others catch up
+    MPI_Iallreduce(&mm->ledgered, &total, 1, MPI_UNSIGNED_LONG, MPI_SUM, comm, &req);
+    while(!done){
+        MM_make_progress(mm);
+        MPI_Test(&req, &done, MPI_STATUS_IGNORE);
+    }
+
+    // Then drain the ledger: the rest is in it or on its way
+    while(mm->em->executed_cnt < total)
+        MM_make_progress(mm);
+    return 0;
+}
+
 int MM_updata_helper_make_progress(metadata_manager* mm){
     assert(mm);
     //DEBUG_PRINT
@@ -281,4 +867,11 @@ time_stamp MM_get_time_stamp_us(){
     return 1000000 * tv.tv_sec + tv.tv_usec;
 }
 
+time_stamp MM_get_global_time_us(metadata_manager* mm){
+    assert(mm);
+    if(mm->clk)
+        return clk_sync_now_us(mm->clk);
+    return MM_get_time_stamp_us();
+}
+
 // ========================== Private functions ==========================
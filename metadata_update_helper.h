@@ -13,9 +13,55 @@
 #include "VotingManager.h"
 #include "LedgerManager.h"
 #include "ExecutionManager.h"
+#include "util_clock.h"
 #include "util_debug.h"
 
 
+#define EPOCH_IDLE          0
+#define EPOCH_SIZES         1   // Iallgather of the per-rank headers
+#define EPOCH_DATA          2   // Iallgatherv of the proposals
+#define EPOCH_MAX_CNT       1024// Default count threshold
+
+// Mode 3: proposals are buffered locally and exchanged with all ranks once
+// per epoch, instead of one consensus round each.
+typedef struct epoch_exchange{
+    MPI_Comm comm;              // Not owned, must outlive the manager
+    int my_rank;
+    int comm_size;
+    unsigned int max_cnt;       // End the epoch at this many buffered proposals,
+    time_stamp interval_us;     // or when it's been open this long.
+
+    /* Buffering epoch */
+    gen_queue buf_q;            // Encoded proposals, in submission order
+    size_t buf_len;
+    time_stamp start_us;
+    int force;                  // End it at the next progress call
+    int closing;                // Set by MM_epoch_finish()
+    int done;                   // An epoch with everyone closing completed
+
+    /* Exchange in flight, at most one */
+    int phase;                  // EPOCH_IDLE, EPOCH_SIZES or EPOCH_DATA
+    MPI_Request req;
+    unsigned long my_hdr[2];    // {bytes, closing}
+    unsigned long* all_hdr;     // comm_size x {bytes, closing}
+    int* recv_cnts;
+    int* displs;
+    char* send_buf;
+    char* recv_buf;
+
+    unsigned long submitted;    // Local proposals buffered so far
+    unsigned long executed;     // Local proposals executed so far
+    unsigned long epoch_cnt;
+}epoch_exchange;
+
+// A proposal submitted with MM_submit_proposal_async(), mode 1 only. Allocated
+// by the caller, which may free it (and p) once state is PS_APPROVED or PS_DENIED.
+typedef struct mm_async_op{
+    proposal* p;                // Still the caller's
+    proposal_state state;       // PS_DEFAULT: queued, PS_IN_PROGRESS: being voted on,
+                                // PS_APPROVED: in the ledger, PS_DENIED: dropped
+}mm_async_op;
+
 typedef struct metadata_update_engine{
     int mode; //0 for regular, 1 for risky.
     time_stamp time_window_size;
@@ -26,6 +72,22 @@ typedef struct metadata_update_engine{
     voting_mgr* vm;
     ledger_mgr* lm;
     execution_mgr* em;
+    clock_sync* clk;//optional, NULL to use the local clock as is.
+    vp_order order;//from the voting plugin
+    time_stamp next_seq;//next sequence # to execute, for VP_ORDER_SEQUENCE
+    epoch_exchange* epoch;//mode 3 only
+    gen_queue async_q;//mm_async_op's not decided yet, only the head is voted on
+    unsigned long ledgered;//my proposals that went into the ledger, see MM_close()
+    // Optional, see MM_set_depends_cb(). NULL keeps the total order.
+    int (*depends_cb)(int op_old, proposal_key key_old, int op_new, proposal_key key_new);
+    unsigned long early;//ledger proposals depends_cb released before they aged out
+    unsigned long voted;//my proposals put up for a vote
+    unsigned long announced;//my proposals broadcast without a vote, see MM_submit_announce()
+    int (*judgement)();//the app's, called through the manager to keep the two below
+    int my_rank;//with depends_cb only, my proposals go out with it as their pid
+    time_stamp* seen_time;//per rank: its newest proposal voted on here
+    gen_queue judged_q;//dep_judged's: approved here, not in the ledger yet
+    time_stamp last_time;//my last proposal's, later ones are stamped after it
 
 //    int my_rank;
 }metadata_manager;
@@ -57,7 +119,43 @@ int MM_ledger_proccess(metadata_manager* meta_eng);
 int MM_execution_proccess(metadata_manager* meta_eng);
 int MM_submit_proposal(metadata_manager* meta_eng, proposal* p);
 int MM_make_progress(metadata_manager *mm);
+// Mode 1: start voting on p and return; MM_make_progress() moves op along.
+int MM_submit_proposal_async(metadata_manager* mm, proposal* p, mm_async_op* op);
+
+// Mode 1: take op back if it's still queued behind the one being voted on,
+// so nobody else has seen it. Returns 1 when withdrawn (op->state is
+// PS_DENIED then, p is the caller's again), 0 when it's too late.
+int MM_withdraw_async(metadata_manager* mm, mm_async_op* op);
+
+// Mode 1: send p to everyone without a vote, for ops nobody else can
+// contend (e.g. under a lease). Returns 1 once it has run here, in ledger
+// order. Plugins that sequence everything just get MM_submit_proposal().
+int MM_submit_announce(metadata_manager* mm, proposal* p);
+
+// Mode 1, time window order only: let a proposal run before its window is
+// up once nothing older it depends on (depends_cb() returns 1: must follow)
+// can still show up here. That takes a newer proposal voted on here from
+// every other rank: a rank's proposals are voted on one at a time, so all
+// its older ones have been seen by then. Proposals it does depend on keep
+// their (time, pid) order, everything else waits out the window as before.
+// Proposal ids are taken as ranks, mine go out as my_rank.
+int MM_set_depends_cb(metadata_manager* mm, int my_rank,
+        int (*depends_cb)(int op_old, proposal_key key_old, int op_new, proposal_key key_new));
+
+// Mode 3 (epoch): must be called by all ranks in comm, right after init.
+int MM_epoch_init(metadata_manager* mm, MPI_Comm comm, unsigned int max_cnt, time_stamp interval_us);
+// End the current epoch now and wait until all my proposals have executed.
+int MM_epoch_wait(metadata_manager* mm);
+// Collective: flush, then stop exchanging once every rank has called it.
+int MM_epoch_finish(metadata_manager* mm);
+
+// Collective, at file close: wait until every rank in comm is here and every
+// proposal any of them got in has executed here. A nonblocking reduction of
+// the 'ledgered' counts stands in for a barrier, progress goes on meanwhile.
+// Mode 3 just ends the epochs.
+int MM_close(metadata_manager* mm, MPI_Comm comm);
 
 time_stamp MM_get_time_stamp_us();//time_stamp in microsec
+time_stamp MM_get_global_time_us(metadata_manager* mm);//in reference timebase when clk is set
 
 #endif /* METADATA_UPDATE_HELPER_H_ */
@@ -28,6 +28,8 @@ proposal* compose_proposal(proposal_id pid, int op_type, void* p_data, size_t p_
     p->isLocal = 0;//set to 1 ONLY when approved and before execute locally.
     p->op_type = op_type;
     p->p_data_len = p_data_len;
+    p->parent_key = 0;
+    p->name_key = NULL;
     p->proposal_data = p_data;//calloc(1, p_data_len);
     p->result_obj_local = NULL;
     //printf("%s:%d: test proposal_data len = %lu, data = %p\n", __func__, __LINE__, p->p_data_len, p->proposal_data);
@@ -41,12 +43,15 @@ void proposal_check(proposal* p){
 }
 
 size_t proposal_encoder(proposal* p, void**buf_out){
+    size_t name_len = p->name_key ? strlen(p->name_key) + 1 : 0;
     size_t cal_size = sizeof(proposal_id) +
             sizeof(proposal_state) +
             sizeof(time_stamp) +
             sizeof(int) +
             sizeof(int) +
             sizeof(size_t) +
+            sizeof(proposal_key) +
+            sizeof(size_t) + name_len +
             p->p_data_len;
 
     //printf("%s:%d: pid = %d\n", __func__, __LINE__, p->pid);
@@ -79,6 +84,16 @@ size_t proposal_encoder(proposal* p, void**buf_out){
     *(size_t*)cur = p->p_data_len;
     cur = (char*)cur + sizeof(size_t);
 
+    *(proposal_key*)cur = p->parent_key;
+    cur = (char*)cur + sizeof(proposal_key);
+
+    *(size_t*)cur = name_len;
+    cur = (char*)cur + sizeof(size_t);
+    if(name_len > 0) {
+        memcpy(cur, p->name_key, name_len);
+        cur = (char*)cur + name_len;
+    }
+
     if(p->p_data_len > 0) {
         memcpy(cur, p->proposal_data, p->p_data_len);
         //cur = (char*)cur + p->p_data_len;
@@ -88,7 +103,11 @@ size_t proposal_encoder(proposal* p, void**buf_out){
 
 //This is called only when you have a proposal_buf
 proposal* proposal_decoder(void* buf_in){
-    proposal* p = calloc(1, sizeof(proposal));
+    size_t hdr_size = sizeof(proposal_id) + sizeof(proposal_state) + sizeof(time_stamp)
+            + sizeof(int) + sizeof(int) + sizeof(size_t) + sizeof(proposal_key);
+    size_t name_len = *(size_t*)((char*)buf_in + hdr_size);
+    // The name goes right after the struct, so free(p) releases it too
+    proposal* p = calloc(1, sizeof(proposal) + name_len);
 
     p->pid = *(proposal_id*)buf_in;
     buf_in = (char*)buf_in + sizeof(proposal_id);
@@ -114,6 +133,18 @@ proposal* proposal_decoder(void* buf_in){
     buf_in = (char*)buf_in + sizeof(size_t);
     //printf("%s:%d: p->p_data_len = %lu\n", __func__, __LINE__, p->p_data_len);
 
+    p->parent_key = *(proposal_key*)buf_in;
+    buf_in = (char*)buf_in + sizeof(proposal_key);
+
+    buf_in = (char*)buf_in + sizeof(size_t);
+    if(name_len > 0) {
+        p->name_key = (char*)(p + 1);
+        memcpy(p->name_key, buf_in, name_len);
+        buf_in = (char*)buf_in + name_len;
+    }
+    else
+        p->name_key = NULL;
+
     if(p->p_data_len > 0) {
         p->proposal_data = calloc(1, p->p_data_len);
         memcpy(p->proposal_data, buf_in, p->p_data_len);
@@ -128,6 +159,37 @@ proposal* proposal_decoder(void* buf_in){
     return p;
 }
 
+// Same layout as proposal_encoder(): pid, state, then time.
+void proposal_buf_set_time(void* buf, time_stamp t){
+    assert(buf);
+    *(time_stamp*)((char*)buf + sizeof(proposal_id) + sizeof(proposal_state)) = t;
+}
+
+void proposal_buf_set_local(void* buf, int isLocal){
+    assert(buf);
+    *(int*)((char*)buf + sizeof(proposal_id) + sizeof(proposal_state) + sizeof(time_stamp)) = isLocal;
+}
+
+size_t proposal_buf_size(void* buf){
+    size_t hdr_size = sizeof(proposal_id) + sizeof(proposal_state) + sizeof(time_stamp)
+            + sizeof(int) + sizeof(int);
+
+    size_t data_len, name_len;
+
+    assert(buf);
+    data_len = *(size_t*)((char*)buf + hdr_size);
+    name_len = *(size_t*)((char*)buf + hdr_size + sizeof(size_t) + sizeof(proposal_key));
+    return hdr_size + sizeof(size_t) + sizeof(proposal_key) + sizeof(size_t) + name_len + data_len;
+}
+
+void proposal_buf_key(void* buf, int* op_type_out, proposal_key* key_out){
+    size_t off = sizeof(proposal_id) + sizeof(proposal_state) + sizeof(time_stamp) + sizeof(int);
+
+    assert(buf && op_type_out && key_out);
+    *op_type_out = *(int*)((char*)buf + off);
+    *key_out = *(proposal_key*)((char*)buf + off + sizeof(int) + sizeof(size_t));
+}
+
 void proposal_buf_test(void* buf_in){
     proposal* p = proposal_decoder(buf_in);
     printf("Checking proposal content: p->pid = %d, p->state = %d, p->time = %lu, p->isLocal = %d, p->op_type = %d, p->p_data_len = %lu\n",
@@ -10,6 +10,7 @@
 
 typedef int proposal_id;
 typedef unsigned long time_stamp;
+typedef unsigned long long proposal_key;
 
 //Defining possible states of a proposal from application side
 typedef enum proposal_state{
@@ -28,6 +29,9 @@ typedef struct proposal_record{
     int isLocal;
     int op_type;
     size_t p_data_len;
+    proposal_key parent_key;//object the op works under (parent addr for VOL), 0 if none
+    char* name_key;//name the op creates under parent_key, NULL if none. Not owned when composed,
+                   //points into the same allocation when decoded.
     void* proposal_data;//for VOL
     void* result_obj_local;//for output
 }proposal;
@@ -37,5 +41,9 @@ time_stamp set_proposal_time(proposal* p);
 proposal_id new_proposal_ID();
 size_t proposal_encoder(proposal* p, void**buf_out);
 proposal* proposal_decoder(void* buf);
+void proposal_buf_set_time(void* buf, time_stamp t);//re-stamp an encoded proposal in place
+void proposal_buf_set_local(void* buf, int isLocal);//same, for the isLocal flag
+size_t proposal_buf_size(void* buf);//total encoded size
+void proposal_buf_key(void* buf, int* op_type_out, proposal_key* key_out);//read op_type and parent_key only
 void proposal_test(proposal* p);
 #endif /* PROPOSAL_H_ */
@@ -27,6 +27,8 @@ HDF5_PLUGIN_PATH=/Users/koziol/HDF5/dev/ind_meta/rlo_vol
 int my_rank;
 int comm_size;
 extern int MY_RANK_DEBUG;
+extern int rlo_codec_bench(int num_ops);
+extern int rlo_hook_bench(const char* file_name, hid_t fapl, int num_calls);
 time_stamp public_get_time_stamp_us(){
     struct timeval tv;
     gettimeofday(&tv, NULL);
@@ -366,6 +368,586 @@ int dset_extend_test(int benchmark_type, const char* file_name, hid_t fapl)
     return t2 - t1;
 }
 
+// Shared log dataset: each rank reserves a block of rows once, then
+// appends into it row by row. Checks the final extent serially.
+unsigned long dset_reserve_test(const char* file_name, hid_t fapl, int rows_per_rank)
+{
+    hid_t file_id, dataset_id, dataspace_id, mem_space_id, file_space_id, dcpl_id;
+    hsize_t dims[2] = {0, 6};
+    hsize_t max_dims[2] = {H5S_UNLIMITED, 6};
+    hsize_t chunk_dims[2] = {10, 6};
+    hsize_t row_dims[2] = {1, 6};
+    hsize_t new_size[2], offset[2], start = 0;
+    int row[6];
+    herr_t status;
+
+    file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    if(my_rank == 0) {
+        dataspace_id = H5Screate_simple(2, dims, max_dims);
+        dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+        status = H5Pset_chunk(dcpl_id, 2, chunk_dims);
+        dataset_id = H5Dcreate2(file_id, "/log", H5T_NATIVE_INT, dataspace_id,
+                               H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+        status = H5Dclose(dataset_id);
+        status = H5Pclose(dcpl_id);
+        status = H5Sclose(dataspace_id);
+    }
+    H5Fclose(file_id);
+
+    file_id = H5Fopen(file_name, H5F_ACC_RDWR, fapl);
+    dataset_id = H5Dopen2(file_id, "/log", H5P_DEFAULT);
+    unsigned long t1 = public_get_time_stamp_us();
+    status = H5VL_rlo_dataset_reserve(dataset_id, rows_per_rank, &start);
+    assert(status >= 0);
+    mem_space_id = H5Screate_simple(2, row_dims, NULL);
+    for(int i = 0; i < rows_per_rank; i++) {
+        /* Appends inside the block don't need proposals */
+        new_size[0] = start + i + 1;
+        new_size[1] = 6;
+        status = H5Dset_extent(dataset_id, new_size);
+        for(int j = 0; j < 6; j++)
+            row[j] = my_rank;
+        offset[0] = start + i;
+        offset[1] = 0;
+        file_space_id = H5Dget_space(dataset_id);
+        status = H5Sselect_hyperslab(file_space_id, H5S_SELECT_SET, offset, NULL, row_dims, NULL);
+        status = H5Dwrite(dataset_id, H5T_NATIVE_INT, mem_space_id, file_space_id, H5P_DEFAULT, row);
+        H5Sclose(file_space_id);
+    }
+    unsigned long t2 = public_get_time_stamp_us();
+    H5Sclose(mem_space_id);
+    status = H5Dclose(dataset_id);
+    H5Fclose(file_id);
+
+    file_id = H5Fopen(file_name, H5F_ACC_RDONLY, H5P_DEFAULT);
+    dataset_id = H5Dopen2(file_id, "/log", H5P_DEFAULT);
+    file_space_id = H5Dget_space(dataset_id);
+    H5Sget_simple_extent_dims(file_space_id, dims, NULL);
+    assert(dims[0] == (hsize_t)rows_per_rank * comm_size);
+    H5Sclose(file_space_id);
+    status = H5Dclose(dataset_id);
+
+// A mode 1 RLO VOL fapl on MPI_COMM_WORLD, from a connector info string
+// like the one in HDF5_VOL_CONNECTOR, e.g. "lazy=1;under_vol=0;under_info={}"
+hid_t rlo_fapl(const char* config){
+    extern const H5VL_class_t H5VL_rlo_pass_through_g;
+    hid_t rlo_vol_id = H5VLregister_connector(&H5VL_rlo_pass_through_g, H5P_DEFAULT);
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+    void* rlo_vol_info = NULL;
+
+    H5Pset_fapl_mpio(fapl, MPI_COMM_WORLD, MPI_INFO_NULL);
+    H5VLconnector_str_to_info(config, rlo_vol_id, &rlo_vol_info);
+    H5Pset_vol(fapl, rlo_vol_id, rlo_vol_info);
+    H5VLfree_connector_info(rlo_vol_id, rlo_vol_info);
+    H5VLclose(rlo_vol_id);
+    return fapl;
+}
+
+// Wait until 'remote' operations of other ranks have reached this rank,
+// each poll makes progress. Fails the run if they don't within a minute.
+#define WAIT_REMOTE_TIMEOUT_US  (60 * 1000 * 1000UL)
+void wait_remote(hid_t file_id, unsigned long remote, H5VL_rlo_stats_t* stats){
+    unsigned long t1 = public_get_time_stamp_us();
+
+    do {
+        herr_t status = H5VL_rlo_get_stats(file_id, stats);
+        assert(status >= 0);
+        if(public_get_time_stamp_us() - t1 > WAIT_REMOTE_TIMEOUT_US){
+            printf("rank %d: timed out waiting for %lu remote operations, got %lu\n",
+                    my_rank, remote, stats->remote);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+    } while(stats->remote < remote);
+}
+
+// Lazy mode: rank 0 creates a group and num_ops datasets in it, and the
+// other ranks journal them. Opening the group applies its own create,
+// opening a dataset in it the rest. Once all ranks are there, rank 0 makes
+// one more create, which a flush applies.
+unsigned long lazy_test(const char* file_name, unsigned long time_window, int num_ops)
+{
+    hid_t fapl, file_id, group_id, space_id, dataset_id;
+    hsize_t dims[2] = {10, 6};
+    H5VL_rlo_stats_t stats;
+    char config[128] = "";
+    char name[64] = "";
+
+    sprintf(config, "time_window=%lu;lazy=1;under_vol=0;under_info={}", time_window);
+    fapl = rlo_fapl(config);
+    file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    space_id = H5Screate_simple(2, dims, NULL);
+    unsigned long t1 = public_get_time_stamp_us();
+    if(my_rank == 0){
+        group_id = H5Gcreate2(file_id, "/lazy", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        for(int j = 0; j < num_ops; j++){
+            sprintf(name, "ds_%d", j);
+            dataset_id = H5Dcreate2(group_id, name, H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            H5Dclose(dataset_id);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+        H5Gclose(H5Gcreate2(group_id, "after_open", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+        H5Gclose(group_id);
+    } else {
+        /* Nothing of it has run here yet */
+        wait_remote(file_id, num_ops + 1, &stats);
+        assert(stats.journaled == (unsigned long)num_ops + 1);
+
+        group_id = H5Gopen2(file_id, "lazy", H5P_DEFAULT);
+        assert(group_id >= 0);
+        H5VL_rlo_get_stats(file_id, &stats);
+        assert(stats.journaled == (unsigned long)num_ops);
+
+        dataset_id = H5Dopen2(group_id, "ds_0", H5P_DEFAULT);
+        assert(dataset_id >= 0);
+        H5Dclose(dataset_id);
+        H5VL_rlo_get_stats(file_id, &stats);
+        assert(stats.journaled == 0);
+        H5Gclose(group_id);
+
+        /* Everything is in everywhere, nobody needs us for progress */
+        MPI_Barrier(MPI_COMM_WORLD);
+        wait_remote(file_id, num_ops + 2, &stats);
+        assert(stats.journaled == 1);
+    }
+    unsigned long t2 = public_get_time_stamp_us();
+    H5Fflush(file_id, H5F_SCOPE_GLOBAL);
+    H5VL_rlo_get_stats(file_id, &stats);
+    assert(stats.journaled == 0);
+    H5Sclose(space_id);
+    H5Fclose(file_id);
+
+    file_id = H5Fopen(file_name, H5F_ACC_RDONLY, fapl);
+    for(int j = 0; j < num_ops; j++){
+        sprintf(name, "/lazy/ds_%d", j);
+        assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+    }
+    assert(H5Lexists(file_id, "/lazy/after_open", H5P_DEFAULT) > 0);
+    H5Fclose(file_id);
+    H5Pclose(fapl);
+    return t2 - t1;
+}
+
+// Mode 1 async creates, through the connector's requests: each rank creates
+// a group and a dataset in the root and waits for both. Ranks 0 and 1 also
+// create a group and a dataset of the same name: exactly one of the pair
+// succeeds, the other one is voted down. They close the handle before
+// waiting on the request.
+unsigned long async_test(const char* file_name, hid_t fapl)
+{
+    hid_t file_id, vol_id, space_id;
+    hsize_t dims[2] = {10, 6};
+    H5VL_loc_params_t loc_params;
+    H5ES_status_t status;
+    void *file_obj, *group_obj, *dataset_obj;
+    void *clash_obj = NULL, *clash_req = NULL;
+    void *group_req = NULL, *dataset_req = NULL;
+    char name[64] = "";
+    int won = 0, winners = 0;
+    herr_t ret;
+
+    file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    space_id = H5Screate_simple(2, dims, NULL);
+    vol_id = H5VLget_connector_id(file_id);
+    file_obj = H5VLobject(file_id);
+    loc_params.type = H5VL_OBJECT_BY_SELF;
+    loc_params.obj_type = H5I_FILE;
+
+    unsigned long t1 = public_get_time_stamp_us();
+    sprintf(name, "/async_group_%d", my_rank);
+    group_obj = H5VLgroup_create(file_obj, &loc_params, vol_id, name, H5P_LINK_CREATE_DEFAULT,
+            H5P_GROUP_CREATE_DEFAULT, H5P_GROUP_ACCESS_DEFAULT, H5P_DATASET_XFER_DEFAULT, &group_req);
+    assert(group_obj && group_req);
+    sprintf(name, "/async_ds_%d", my_rank);
+    dataset_obj = H5VLdataset_create(file_obj, &loc_params, vol_id, name, H5P_LINK_CREATE_DEFAULT,
+            H5T_NATIVE_INT, space_id, H5P_DATASET_CREATE_DEFAULT, H5P_DATASET_ACCESS_DEFAULT,
+            H5P_DATASET_XFER_DEFAULT, &dataset_req);
+    assert(dataset_obj && dataset_req);
+    if(my_rank == 0)
+        clash_obj = H5VLgroup_create(file_obj, &loc_params, vol_id, "/async_clash", H5P_LINK_CREATE_DEFAULT,
+                H5P_GROUP_CREATE_DEFAULT, H5P_GROUP_ACCESS_DEFAULT, H5P_DATASET_XFER_DEFAULT, &clash_req);
+    else if(my_rank == 1)
+        clash_obj = H5VLdataset_create(file_obj, &loc_params, vol_id, "/async_clash", H5P_LINK_CREATE_DEFAULT,
+                H5T_NATIVE_INT, space_id, H5P_DATASET_CREATE_DEFAULT, H5P_DATASET_ACCESS_DEFAULT,
+                H5P_DATASET_XFER_DEFAULT, &clash_req);
+
+    /* A completed request is released by the wait */
+    ret = H5VLrequest_wait(group_req, vol_id, UINT64_MAX, &status);
+    assert(ret >= 0 && status == H5ES_STATUS_SUCCEED);
+    ret = H5VLrequest_wait(dataset_req, vol_id, UINT64_MAX, &status);
+    assert(ret >= 0 && status == H5ES_STATUS_SUCCEED);
+
+    /* The clash's handle goes first, its request still knows the outcome */
+    if(clash_obj && my_rank == 0)
+        H5VLgroup_close(clash_obj, vol_id, H5P_DATASET_XFER_DEFAULT, NULL);
+    else if(clash_obj)
+        H5VLdataset_close(clash_obj, vol_id, H5P_DATASET_XFER_DEFAULT, NULL);
+    if(clash_req) {
+        ret = H5VLrequest_wait(clash_req, vol_id, UINT64_MAX, &status);
+        assert(ret >= 0 && status != H5ES_STATUS_IN_PROGRESS);
+        won = (status == H5ES_STATUS_SUCCEED);
+    }
+    unsigned long t2 = public_get_time_stamp_us();
+
+    H5VLgroup_close(group_obj, vol_id, H5P_DATASET_XFER_DEFAULT, NULL);
+    H5VLdataset_close(dataset_obj, vol_id, H5P_DATASET_XFER_DEFAULT, NULL);
+    MPI_Allreduce(&won, &winners, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    assert(winners == 1);
+    H5VLclose(vol_id);
+    H5Sclose(space_id);
+    H5Fclose(file_id);
+
+    file_id = H5Fopen(file_name, H5F_ACC_RDONLY, H5P_DEFAULT);
+    for(int r = 0; r < comm_size; r++){
+        sprintf(name, "/async_group_%d", r);
+        assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+        sprintf(name, "/async_ds_%d", r);
+        assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+    }
+    assert(H5Lexists(file_id, "/async_clash", H5P_DEFAULT) > 0);
+    H5Fclose(file_id);
+    return t2 - t1;
+}
+
+// Commute mode with a long window: each rank creates a group and num_ops
+// datasets in it. They don't depend on other ranks' pending creates, so
+// they run as soon as they're approved instead of after the window.
+unsigned long commute_test(const char* file_name, unsigned long time_window, int num_ops)
+{
+    hid_t fapl, file_id, group_id, space_id, dataset_id;
+    hsize_t dims[2] = {10, 6};
+    H5VL_rlo_stats_t stats;
+    char config[128] = "";
+    char name[64] = "";
+
+    sprintf(config, "time_window=%lu;commute=1;under_vol=0;under_info={}", time_window);
+    fapl = rlo_fapl(config);
+    file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    space_id = H5Screate_simple(2, dims, NULL);
+    unsigned long t1 = public_get_time_stamp_us();
+    sprintf(name, "/commute_%d", my_rank);
+    group_id = H5Gcreate2(file_id, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    for(int j = 0; j < num_ops; j++){
+        sprintf(name, "ds_%d", j);
+        dataset_id = H5Dcreate2(group_id, name, H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        H5Dclose(dataset_id);
+    }
+    H5Gclose(group_id);
+    unsigned long t2 = public_get_time_stamp_us();
+
+    /* Waiting out the window would take num_ops + 1 windows */
+    H5VL_rlo_get_stats(file_id, &stats);
+    assert(stats.early > 0);
+    assert(t2 - t1 < (num_ops / 2) * time_window);
+
+    wait_remote(file_id, (unsigned long)(comm_size - 1) * (num_ops + 1), &stats);
+    for(int r = 0; r < comm_size; r++){
+        for(int j = 0; j < num_ops; j++){
+            sprintf(name, "/commute_%d/ds_%d", r, j);
+            assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+        }
+    }
+    H5Sclose(space_id);
+    H5Fclose(file_id);
+
+    file_id = H5Fopen(file_name, H5F_ACC_RDONLY, fapl);
+    for(int r = 0; r < comm_size; r++){
+        sprintf(name, "/commute_%d/ds_%d", r, num_ops - 1);
+        assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+    }
+    H5Fclose(file_id);
+    H5Pclose(fapl);
+    return t2 - t1;
+}
+
+// Lease mode: each rank creates a group, which is voted on, and num_ops
+// datasets in it, which are only announced. Then each rank creates one
+// group in the next rank's group: that ends the next rank's lease, so its
+// next create in its own group is voted on again.
+unsigned long lease_test(const char* file_name, unsigned long time_window, int num_ops)
+{
+    hid_t fapl, file_id, group_id, space_id, dataset_id;
+    hsize_t dims[2] = {10, 6};
+    H5VL_rlo_stats_t before, stats;
+    unsigned long remote = 0;
+    char config[128] = "";
+    char name[64] = "";
+
+    sprintf(config, "time_window=%lu;lease=1;under_vol=0;under_info={}", time_window);
+    fapl = rlo_fapl(config);
+    file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    space_id = H5Screate_simple(2, dims, NULL);
+    unsigned long t1 = public_get_time_stamp_us();
+    H5VL_rlo_get_stats(file_id, &before);
+    sprintf(name, "/lease_%d", my_rank);
+    group_id = H5Gcreate2(file_id, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5VL_rlo_get_stats(file_id, &stats);
+    assert(stats.votes == before.votes + 1);
+
+    before = stats;
+    for(int j = 0; j < num_ops; j++){
+        sprintf(name, "ds_%d", j);
+        dataset_id = H5Dcreate2(group_id, name, H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        H5Dclose(dataset_id);
+    }
+    H5VL_rlo_get_stats(file_id, &stats);
+    assert(stats.votes == before.votes);
+    assert(stats.announced == before.announced + num_ops);
+    unsigned long t2 = public_get_time_stamp_us();
+    remote = (unsigned long)(comm_size - 1) * (num_ops + 1);
+    wait_remote(file_id, remote, &stats);
+
+    if(comm_size > 1){
+        hid_t guest_id;
+
+        sprintf(name, "/lease_%d", (my_rank + 1) % comm_size);
+        guest_id = H5Gopen2(file_id, name, H5P_DEFAULT);
+        assert(guest_id >= 0);
+        sprintf(name, "guest_%d", my_rank);
+        H5Gclose(H5Gcreate2(guest_id, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+        H5Gclose(guest_id);
+
+        /* My vote on the previous rank's guest ended my lease */
+        wait_remote(file_id, remote + comm_size - 1, &before);
+        H5Gclose(H5Gcreate2(group_id, "after_guest", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+        H5VL_rlo_get_stats(file_id, &stats);
+        assert(stats.votes == before.votes + 1);
+        assert(stats.announced == before.announced);
+    }
+    H5Gclose(group_id);
+    H5Sclose(space_id);
+    H5Fclose(file_id);
+
+    file_id = H5Fopen(file_name, H5F_ACC_RDONLY, fapl);
+    for(int r = 0; r < comm_size; r++){
+        sprintf(name, "/lease_%d/ds_%d", r, num_ops - 1);
+        assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+        if(comm_size > 1){
+            sprintf(name, "/lease_%d/guest_%d", (r + 1) % comm_size, r);
+            assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+        }
+    }
+    H5Fclose(file_id);
+    H5Pclose(fapl);
+    return t2 - t1;
+}
+
+// Each rank creates a group and num_objs datasets in it with one proposal.
+unsigned long create_multi_test(const char* file_name, hid_t fapl, int num_objs)
+{
+    hid_t file_id, dataspace_id;
+    hsize_t dims[2] = {10, 6};
+    H5VL_rlo_create_t* objs = calloc(num_objs + 1, sizeof(H5VL_rlo_create_t));
+    hid_t* ids = calloc(num_objs + 1, sizeof(hid_t));
+    char (*names)[64] = calloc(num_objs + 1, 64);
+    herr_t status;
+
+    file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    dataspace_id = H5Screate_simple(2, dims, NULL);
+    sprintf(names[0], "multi_group_%d", my_rank);
+    objs[0].loc_id = file_id;
+    objs[0].name = names[0];
+    objs[0].type_id = H5I_INVALID_HID;
+    objs[0].lcpl_id = objs[0].cpl_id = objs[0].apl_id = H5P_DEFAULT;
+    for(int i = 1; i <= num_objs; i++){
+        sprintf(names[i], "multi_ds_%d_%d", my_rank, i);
+        objs[i].loc_id = file_id;
+        objs[i].name = names[i];
+        objs[i].type_id = H5T_NATIVE_INT;
+        objs[i].space_id = dataspace_id;
+        objs[i].lcpl_id = objs[i].cpl_id = objs[i].apl_id = H5P_DEFAULT;
+    }
+
+    unsigned long t1 = public_get_time_stamp_us();
+    status = H5VL_rlo_create_multi(num_objs + 1, objs, ids);
+    unsigned long t2 = public_get_time_stamp_us();
+    assert(status >= 0);
+    for(int i = 0; i <= num_objs; i++)
+        H5Oclose(ids[i]);
+
+    H5Sclose(dataspace_id);
+    H5Fclose(file_id);
+
+    /* Everyone's objects are in the file */
+    file_id = H5Fopen(file_name, H5F_ACC_RDONLY, H5P_DEFAULT);
+    for(int r = 0; r < comm_size; r++){
+        sprintf(names[0], "multi_ds_%d_%d", r, num_objs);
+        assert(H5Lexists(file_id, names[0], H5P_DEFAULT) > 0);
+    }
+    H5Fclose(file_id);
+    free(names);
+    free(ids);
+    free(objs);
+    return t2 - t1;
+}
+
+// Each rank restructures its own part of the file independently: groups,
+// then hard and soft links to them, a copy, a rename and an unlink, and
+// attributes on the root group it prunes again.
+unsigned long link_test(const char* file_name, hid_t fapl, int num_ops)
+{
+    hid_t file_id, group_id;
+    char name[64] = "";
+    char target[64] = "";
+    herr_t status;
+
+    file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    unsigned long t1 = public_get_time_stamp_us();
+    for(int j = 0; j < num_ops; j++){
+        sprintf(name, "/link_group_%d_%d", my_rank, j);
+        group_id = H5Gcreate2(file_id, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        H5Gclose(group_id);
+
+        sprintf(target, "/link_hard_%d_%d", my_rank, j);
+        status = H5Lcreate_hard(file_id, name, H5L_SAME_LOC, target, H5P_DEFAULT, H5P_DEFAULT);
+        assert(status >= 0);
+        sprintf(target, "/link_soft_%d_%d", my_rank, j);
+        status = H5Lcreate_soft(name, file_id, target, H5P_DEFAULT, H5P_DEFAULT);
+        assert(status >= 0);
+        sprintf(target, "/link_copy_%d_%d", my_rank, j);
+        status = H5Ocopy(file_id, name, file_id, target, H5P_DEFAULT, H5P_DEFAULT);
+        assert(status >= 0);
+        sprintf(target, "/link_moved_%d_%d", my_rank, j);
+        status = H5Lmove(file_id, name, H5L_SAME_LOC, target, H5P_DEFAULT, H5P_DEFAULT);
+        assert(status >= 0);
+        sprintf(target, "/link_hard_%d_%d", my_rank, j);
+        status = H5Ldelete(file_id, target, H5P_DEFAULT);
+        assert(status >= 0);
+
+        sprintf(target, "ckpt_%d_%d", my_rank, j);
+        hid_t space_id = H5Screate(H5S_SCALAR);
+        hid_t attr_id = H5Acreate2(file_id, target, H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT);
+        H5Aclose(attr_id);
+        H5Sclose(space_id);
+        if(j > 0){
+            sprintf(target, "ckpt_%d_%d", my_rank, j - 1);
+            status = H5Adelete(file_id, target);
+            assert(status >= 0);
+        }
+    }
+    unsigned long t2 = public_get_time_stamp_us();
+    H5Fclose(file_id);
+
+    /* Everyone's changes are in the file */
+    file_id = H5Fopen(file_name, H5F_ACC_RDONLY, H5P_DEFAULT);
+    for(int r = 0; r < comm_size; r++) {
+        for(int j = 0; j < num_ops; j++){
+            sprintf(name, "/link_group_%d_%d", r, j);
+            assert(H5Lexists(file_id, name, H5P_DEFAULT) == 0);
+            sprintf(name, "/link_moved_%d_%d", r, j);
+            assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+            sprintf(name, "/link_copy_%d_%d", r, j);
+            assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+            sprintf(name, "/link_soft_%d_%d", r, j);
+            assert(H5Lexists(file_id, name, H5P_DEFAULT) > 0);
+            sprintf(name, "/link_hard_%d_%d", r, j);
+            assert(H5Lexists(file_id, name, H5P_DEFAULT) == 0);
+            sprintf(name, "ckpt_%d_%d", r, j);
+            assert(H5Aexists(file_id, name) == (j == num_ops - 1));
+        }
+    }
+    H5Fclose(file_id);
+    return t2 - t1;
+}
+
+// Every rank makes the same creates: a group with the collective hint, and
+// a dataset in it without one. Each runs once, every rank gets a handle.
+unsigned long collective_test(const char* file_name, hid_t fapl)
+{
+    hid_t file_id, lcpl_id, group_id, space_id, dataset_id;
+    hsize_t dims[2] = {10, 6};
+
+    file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    space_id = H5Screate_simple(2, dims, NULL);
+    lcpl_id = H5Pcreate(H5P_LINK_CREATE);
+    H5VL_rlo_set_collective(lcpl_id, 1);
+
+    unsigned long t1 = public_get_time_stamp_us();
+    group_id = H5Gcreate2(file_id, "/shared_group", lcpl_id, H5P_DEFAULT, H5P_DEFAULT);
+    assert(group_id >= 0);
+    dataset_id = H5Dcreate2(group_id, "shared_ds", H5T_NATIVE_INT, space_id,
+            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    assert(dataset_id >= 0);
+    unsigned long t2 = public_get_time_stamp_us();
+
+    H5Dclose(dataset_id);
+    H5Gclose(group_id);
+    H5Pclose(lcpl_id);
+    H5Sclose(space_id);
+    H5Fclose(file_id);
+
+    file_id = H5Fopen(file_name, H5F_ACC_RDONLY, H5P_DEFAULT);
+    assert(H5Lexists(file_id, "/shared_group/shared_ds", H5P_DEFAULT) > 0);
+    H5Fclose(file_id);
+    return t2 - t1;
+}
+
+// Time num_ops independent group creates per rank with one voting plugin,
+// on the first sub_size ranks only. Returns the slowest rank's time.
+unsigned long voting_plugin_test(H5VL_rlo_voting_t voting, int sub_size,
+        unsigned long time_window, int num_ops){
+    MPI_Comm sub_comm;
+    unsigned long t = 0, t_max = 0;
+    int in_sub = (my_rank < sub_size);
+
+    MPI_Comm_split(MPI_COMM_WORLD, in_sub ? 1 : MPI_UNDEFINED, my_rank, &sub_comm);
+    if(in_sub){
+        extern const H5VL_class_t H5VL_rlo_pass_through_g;
+        hid_t rlo_vol_id = H5VLregister_connector(&H5VL_rlo_pass_through_g, H5P_DEFAULT);
+        H5VL_rlo_pass_through_info_t rlo_vol_info;
+        hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+        char file_name[64] = "";
+        char group_name[32] = "";
+
+        memset(&rlo_vol_info, 0, sizeof(rlo_vol_info));
+        H5Pset_fapl_mpio(fapl, sub_comm, MPI_INFO_NULL);
+        rlo_vol_info.under_vol_id = H5VLregister_connector_by_value(0, H5P_DEFAULT);
+        rlo_vol_info.under_vol_info = NULL;
+        rlo_vol_info.mpi_comm = sub_comm;
+        rlo_vol_info.mpi_info = MPI_INFO_NULL;
+        rlo_vol_info.time_window_size = time_window;
+        rlo_vol_info.mode = 1;
+        MPI_Comm_size(sub_comm, &rlo_vol_info.world_size);
+        MPI_Comm_rank(sub_comm, &rlo_vol_info.my_rank);
+        rlo_vol_info.voting = voting;
+        H5Pset_vol(fapl, rlo_vol_id, &rlo_vol_info);
+        H5VLclose(rlo_vol_id);
+
+        sprintf(file_name, "rlo_voting_%d_%d.h5", (int)voting, sub_size);
+        hid_t file_id = H5Fcreate(file_name, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+        unsigned long t1 = public_get_time_stamp_us();
+        for(int j = 0; j < num_ops; j++){
+            sprintf(group_name, "/group_%d_%d", my_rank, j);
+            hid_t group_id = H5Gcreate2(file_id, group_name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            H5Gclose(group_id);
+        }
+        t = public_get_time_stamp_us() - t1;
+        H5Fclose(file_id);
+        H5Pclose(fapl);
+
+        MPI_Reduce(&t, &t_max, 1, MPI_UNSIGNED_LONG, MPI_MAX, 0, sub_comm);
+        MPI_Comm_free(&sub_comm);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    return t_max;
+}
+
+// Rootless voting vs. the central sequencer, for 2, 4, ... comm_size ranks.
+void voting_crossover_test(unsigned long time_window, int num_ops){
+    for(int sub_size = 2; ; sub_size *= 2){
+        if(sub_size > comm_size)
+            sub_size = comm_size;
+
+        unsigned long t_rlo = voting_plugin_test(H5VL_RLO_VOTING_RLO, sub_size, time_window, num_ops);
+        unsigned long t_seq = voting_plugin_test(H5VL_RLO_VOTING_SEQ, sub_size, time_window, num_ops);
+        if(my_rank == 0)
+            printf("HDF5 RLO VOL crossover: ranks = %d, rlo took %lu usec, seq took %lu usec, avg = %lu / %lu\n",
+                    sub_size, t_rlo, t_seq, t_rlo / num_ops, t_seq / num_ops);
+
+        if(sub_size == comm_size)
+            break;
+    }
+}
+
 int main(int argc, char* argv[])
 {
     hid_t fapl;
@@ -379,12 +961,33 @@ int main(int argc, char* argv[])
     MY_RANK_DEBUG = my_rank;
     int benchmark_type = 0;
     unsigned long time_window = 50;
+    H5VL_rlo_voting_t voting = H5VL_RLO_VOTING_RLO;
+    int crossover = 0;
+    int codec = 0;
+    int hook = 0;
     //printf("1\n");
-    if(argc == 4){
+    if(argc == 4 || argc == 5){
         benchmark_type = atoi(argv[1]);
         time_window = atoi(argv[2]);
         int sleep_time = atoi(argv[3]);
 
+        // Optional voting plugin: "rlo" (default), "rma", "seq" or "posix", or
+        // "crossover" to compare rlo and seq over growing rank counts, or
+        // "codec" to time the proposal parameter encoders and decoders, or
+        // "hook" to time the data path progress hook.
+        if(argc == 5 && !strcmp(argv[4], "rma"))
+            voting = H5VL_RLO_VOTING_RMA;
+        else if(argc == 5 && !strcmp(argv[4], "seq"))
+            voting = H5VL_RLO_VOTING_SEQ;
+        else if(argc == 5 && !strcmp(argv[4], "posix"))
+            voting = H5VL_RLO_VOTING_POSIX;
+        else if(argc == 5 && !strcmp(argv[4], "crossover"))
+            crossover = 1;
+        else if(argc == 5 && !strcmp(argv[4], "codec"))
+            codec = 1;
+        else if(argc == 5 && !strcmp(argv[4], "hook"))
+            hook = 1;
+
         sleep(sleep_time);
     } else if(argc == 3){
         //set to use RLO VOL
@@ -415,6 +1018,7 @@ int main(int argc, char* argv[])
        	hid_t rlo_vol_id = H5VLregister_connector(&H5VL_rlo_pass_through_g, H5P_DEFAULT);
         H5VL_rlo_pass_through_info_t rlo_vol_info;
 
+        memset(&rlo_vol_info, 0, sizeof(rlo_vol_info));
         //hid_t baseline_vol_id = H5VLregister_connector_by_value(0, H5P_DEFAULT);
 
         rlo_vol_info.under_vol_id = H5VLregister_connector_by_value(0, H5P_DEFAULT);
@@ -427,6 +1031,7 @@ int main(int argc, char* argv[])
         rlo_vol_info.mode = benchmark_type;
         rlo_vol_info.world_size = comm_size;
         rlo_vol_info.my_rank = my_rank;
+        rlo_vol_info.voting = voting;
         H5Pset_vol(fapl, rlo_vol_id, &rlo_vol_info);
         //printf("1.6\n");
 
@@ -434,6 +1039,29 @@ int main(int argc, char* argv[])
     }
 
     int num_ops = 1;
+    if(crossover){
+        voting_crossover_test(time_window, 100);
+        H5Pclose(fapl);
+        H5close();
+        MPI_Finalize();
+        return 0;
+    }
+    if(codec){
+        if(my_rank == 0)
+            rlo_codec_bench(100000);
+        H5Pclose(fapl);
+        H5close();
+        MPI_Finalize();
+        return 0;
+    }
+    if(hook){
+        if(benchmark_type != 0)
+            rlo_hook_bench(file_name, fapl, 1000000);
+        H5Pclose(fapl);
+        H5close();
+        MPI_Finalize();
+        return 0;
+    }
     //========================  Sub Test cases  ======================
     unsigned long t;
     t = ds_test(benchmark_type, file_name, fapl, num_ops);
@@ -450,6 +1078,33 @@ int main(int argc, char* argv[])
 
     t = dt_commit_test(benchmark_type, file_name, fapl, num_ops);
     printf("HDF5 RLO VOL test done. dt_commit_test took %lu usec,  avg = %lu\n", t, (t / num_ops));
+
+    if(benchmark_type != 0){
+        t = dset_reserve_test(file_name, fapl, 20);
+        printf("HDF5 RLO VOL test done. dset_reserve_test took %lu usec,  avg = %lu\n", t, (t / 20));
+
+        t = create_multi_test(file_name, fapl, 20);
+        printf("HDF5 RLO VOL test done. create_multi_test took %lu usec,  avg = %lu\n", t, (t / 21));
+
+        t = link_test(file_name, fapl, num_ops);
+        printf("HDF5 RLO VOL test done. link_test took %lu usec,  avg = %lu\n", t, (t / num_ops));
+
+        t = collective_test(file_name, fapl);
+        printf("HDF5 RLO VOL test done. collective_test took %lu usec,  avg = %lu\n", t, (t / 2));
+    }
+    if(benchmark_type == 1){
+        t = lazy_test(file_name, time_window, 20);
+        printf("HDF5 RLO VOL test done. lazy_test took %lu usec,  avg = %lu\n", t, (t / 22));
+
+        t = async_test(file_name, fapl);
+        printf("HDF5 RLO VOL test done. async_test took %lu usec,  avg = %lu\n", t, (t / 2));
+
+        t = commute_test(file_name, 1000 * 1000, 10);
+        printf("HDF5 RLO VOL test done. commute_test took %lu usec,  avg = %lu\n", t, (t / 11));
+
+        t = lease_test(file_name, time_window, 10);
+        printf("HDF5 RLO VOL test done. lease_test took %lu usec,  avg = %lu\n", t, (t / 11));
+    }
     //=================================================================
     H5Pclose(fapl);
 
@@ -0,0 +1,167 @@
+/*
+ * util_clock.c
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <sys/time.h>
+
+#include "util_clock.h"
+
+#define CLK_TAG_PING    0
+#define CLK_TAG_PONG    1
+
+// ========================== Private functions ==========================
+
+static double _clk_local_us(clock_sync* clk){
+    return (double)clk->base_wall_us + (MPI_Wtime() - clk->base_wtime) * 1000000.0;
+}
+
+// Keep the sample with the smallest round trip, it has the tightest error
+// bound (rtt/2). Later samples within 2x of the best are taken as well, so
+// drift between the two clocks is still tracked.
+static void _clk_add_sample(clock_sync* clk, double t0, double t_ref, double t1){
+    double rtt = t1 - t0;
+    double offset = t_ref + rtt / 2 - t1;
+
+    if(clk->sample_cnt == 0 || rtt <= clk->best_rtt_us){
+        clk->best_rtt_us = rtt;
+        clk->offset_us = offset;
+    } else if(rtt <= 2 * clk->best_rtt_us)
+        clk->offset_us = offset;
+
+    clk->sample_cnt++;
+    clk->last_sync_us = (time_stamp)t1;
+}
+
+static void _clk_serve_pings(clock_sync* clk){
+    int done = 1;
+    MPI_Status stat;
+
+    while(done){
+        MPI_Test(&(clk->serve_req), &done, &stat);
+        if(done){
+            double t_ref = _clk_local_us(clk);
+            MPI_Send(&t_ref, 1, MPI_DOUBLE, stat.MPI_SOURCE, CLK_TAG_PONG, clk->comm);
+            MPI_Irecv(&(clk->serve_buf), 1, MPI_CHAR, MPI_ANY_SOURCE, CLK_TAG_PING,
+                    clk->comm, &(clk->serve_req));
+        }
+    }
+}
+
+static void _clk_ping_complete(clock_sync* clk){
+    MPI_Wait(&(clk->ping_req), MPI_STATUS_IGNORE);
+    _clk_add_sample(clk, clk->ping_t0, clk->pong_buf, _clk_local_us(clk));
+    clk->ping_outstanding = 0;
+}
+
+// ========================== Public functions ==========================
+
+clock_sync* clk_sync_init(MPI_Comm comm, int ref_rank, int rounds, time_stamp interval_us){
+    clock_sync* clk = calloc(1, sizeof(clock_sync));
+    struct timeval tv;
+
+    clk->comm = comm;
+    MPI_Comm_rank(comm, &(clk->my_rank));
+    MPI_Comm_size(comm, &(clk->comm_size));
+    clk->ref_rank = ref_rank;
+    clk->interval_us = interval_us;
+    clk->ping_req = MPI_REQUEST_NULL;
+    clk->pong_req = MPI_REQUEST_NULL;
+    clk->serve_req = MPI_REQUEST_NULL;
+
+    gettimeofday(&tv, NULL);
+    clk->base_wtime = MPI_Wtime();
+    clk->base_wall_us = 1000000 * tv.tv_sec + tv.tv_usec;
+
+    if(clk->comm_size == 1)
+        return clk;
+
+    if(clk->my_rank == ref_rank){
+        int to_serve = (clk->comm_size - 1) * rounds;
+        for(int i = 0; i < to_serve; i++){
+            MPI_Status stat;
+            double t_ref;
+
+            MPI_Recv(&(clk->serve_buf), 1, MPI_CHAR, MPI_ANY_SOURCE, CLK_TAG_PING, comm, &stat);
+            t_ref = _clk_local_us(clk);
+            MPI_Send(&t_ref, 1, MPI_DOUBLE, stat.MPI_SOURCE, CLK_TAG_PONG, comm);
+        }
+        MPI_Irecv(&(clk->serve_buf), 1, MPI_CHAR, MPI_ANY_SOURCE, CLK_TAG_PING, comm, &(clk->serve_req));
+        clk->last_sync_us = (time_stamp)_clk_local_us(clk);
+    } else {
+        for(int i = 0; i < rounds; i++){
+            double t0, t_ref;
+
+            t0 = _clk_local_us(clk);
+            MPI_Send(&(clk->ping_buf), 1, MPI_CHAR, ref_rank, CLK_TAG_PING, comm);
+            MPI_Recv(&t_ref, 1, MPI_DOUBLE, ref_rank, CLK_TAG_PONG, comm, MPI_STATUS_IGNORE);
+            _clk_add_sample(clk, t0, t_ref, _clk_local_us(clk));
+        }
+    }
+    //printf("%s:%d: rank = %d, offset = %.1f us, best rtt = %.1f us\n",
+    //        __func__, __LINE__, clk->my_rank, clk->offset_us, clk->best_rtt_us);
+    return clk;
+}
+
+int clk_sync_make_progress(clock_sync* clk){
+    assert(clk);
+
+    if(clk->comm_size == 1)
+        return 0;
+
+    if(clk->my_rank == clk->ref_rank){
+        _clk_serve_pings(clk);
+        return 0;
+    }
+
+    if(clk->ping_outstanding){
+        int done = 0;
+        MPI_Test(&(clk->pong_req), &done, MPI_STATUS_IGNORE);
+        if(done)
+            _clk_ping_complete(clk);
+    } else if((_clk_local_us(clk) - clk->last_sync_us) > clk->interval_us){
+        clk->ping_outstanding = 1;
+        MPI_Irecv(&(clk->pong_buf), 1, MPI_DOUBLE, clk->ref_rank, CLK_TAG_PONG, clk->comm, &(clk->pong_req));
+        clk->ping_t0 = _clk_local_us(clk);
+        MPI_Isend(&(clk->ping_buf), 1, MPI_CHAR, clk->ref_rank, CLK_TAG_PING, clk->comm, &(clk->ping_req));
+    }
+    return 0;
+}
+
+time_stamp clk_sync_now_us(clock_sync* clk){
+    assert(clk);
+    return (time_stamp)(_clk_local_us(clk) + clk->offset_us);
+}
+
+int clk_sync_term(clock_sync* clk){
+    MPI_Request bar_req;
+    int done = 0;
+
+    assert(clk);
+    if(clk->comm_size > 1){
+        // Finish my own ping first, the reference rank keeps serving until
+        // everyone has reached the barrier.
+        if(clk->ping_outstanding){
+            MPI_Wait(&(clk->pong_req), MPI_STATUS_IGNORE);
+            _clk_ping_complete(clk);
+        }
+
+        MPI_Ibarrier(clk->comm, &bar_req);
+        while(!done){
+            if(clk->my_rank == clk->ref_rank)
+                _clk_serve_pings(clk);
+            MPI_Test(&bar_req, &done, MPI_STATUS_IGNORE);
+        }
+
+        if(clk->serve_req != MPI_REQUEST_NULL){
+            MPI_Cancel(&(clk->serve_req));
+            MPI_Wait(&(clk->serve_req), MPI_STATUS_IGNORE);
+        }
+    }
+    free(clk);
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * util_clock.h
+ *
+ *  Created on: Oct 18, 2026
+ *
+ *  Clock-offset estimation against a reference rank, so proposal timestamps
+ *  from different nodes can be compared against one time window.
+ */
+
+#ifndef UTIL_CLOCK_H_
+#define UTIL_CLOCK_H_
+
+#include <mpi.h>
+#include "proposal.h"
+
+#define CLK_REF_RANK_DEFAULT        0
+#define CLK_INIT_ROUNDS             8           // ping-pongs per rank at init
+#define CLK_RECALIBRATE_INTERVAL    1000000     // usec between background re-calibrations
+
+typedef struct clock_sync_ctx{
+    MPI_Comm comm;          // Not owned, must outlive this object
+    int my_rank;
+    int comm_size;
+    int ref_rank;
+
+    /* Local timebase: wall clock at init, advanced with MPI_Wtime() */
+    time_stamp base_wall_us;
+    double base_wtime;
+
+    double offset_us;       // reference time = local time + offset
+    double best_rtt_us;     // smallest round trip seen, used to filter samples
+    time_stamp last_sync_us;// local time of last accepted sample
+    time_stamp interval_us; // background re-calibration period
+    int sample_cnt;
+
+    /* Background ping on non-reference ranks */
+    int ping_outstanding;
+    double ping_t0;
+    char ping_buf;
+    double pong_buf;
+    MPI_Request ping_req;
+    MPI_Request pong_req;
+
+    /* Ping service on the reference rank */
+    char serve_buf;
+    MPI_Request serve_req;
+}clock_sync;
+
+// Blocking calibration, must be called by all ranks in comm.
+clock_sync* clk_sync_init(MPI_Comm comm, int ref_rank, int rounds, time_stamp interval_us);
+
+// Non-blocking, answer pings on the reference rank, or refresh the offset
+// on others when the interval is up.
+int clk_sync_make_progress(clock_sync* clk);
+
+// Current time in the reference rank's timebase, in microsec.
+time_stamp clk_sync_now_us(clock_sync* clk);
+
+// Must be called by all ranks in comm.
+int clk_sync_term(clock_sync* clk);
+
+#endif /* UTIL_CLOCK_H_ */